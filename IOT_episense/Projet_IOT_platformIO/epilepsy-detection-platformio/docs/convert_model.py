@@ -1,16 +1,26 @@
 import binascii
 import os
+import sys
 
 os.chdir(r'C:\Users\valen\OneDrive\Documents\Projet_IOT')
 
+# Modèle à convertir (epilepsy_model_folded.tflite : voir fold_scaler.py)
+tflite_file = sys.argv[1] if len(sys.argv) > 1 else 'epilepsy_model_quantized.tflite'
+
+# Un modèle à scaler intégré consomme les features brutes : en-tête distinct,
+# marqué MODEL_SCALER_FOLDED, inclus seulement par env:esp32dev_folded
+folded = os.path.basename(tflite_file).endswith('_folded.tflite')
+header_file = 'model_data_folded.h' if folded else 'model_data.h'
+guard = 'MODEL_DATA_FOLDED_H' if folded else 'MODEL_DATA_H'
+
 print("="*70)
 print("CONVERSION DU MODÈLE TFLITE EN CODE C")
 print("="*70)
 
 print(f"\nDossier de travail: {os.getcwd()}")
 
-if not os.path.exists('epilepsy_model_quantized.tflite'):
-    print("\n ERREUR: epilepsy_model_quantized.tflite non trouvé!")
+if not os.path.exists(tflite_file):
+    print(f"\n ERREUR: {tflite_file} non trouvé!")
     print(f"   Dossier actuel: {os.getcwd()}")
     print("\nFichiers présents dans ce dossier:")
     for f in os.listdir('.'):
@@ -18,20 +28,23 @@ if not os.path.exists('epilepsy_model_quantized.tflite'):
     exit(1)
 
 # Lire le fichier TFLite
-with open('epilepsy_model_quantized.tflite', 'rb') as f:
+with open(tflite_file, 'rb') as f:
     model = f.read()
 
 print(f"\n✓ Modèle chargé: {len(model)} bytes ({len(model)/1024:.2f} KB)")
 
 # Convertir en array C
-with open('model_data.h', 'w') as f:
+with open(header_file, 'w') as f:
     f.write('// Modèle TensorFlow Lite - Détection Crises Épileptiques\n')
     f.write(f'// Taille: {len(model)} bytes ({len(model)/1024:.2f} KB)\n')
     f.write('// Accuracy: 99.46%\n')
     f.write('// Dataset: Epileptic Seizure Recognition\n\n')
     
-    f.write('#ifndef MODEL_DATA_H\n')
-    f.write('#define MODEL_DATA_H\n\n')
+    f.write(f'#ifndef {guard}\n')
+    f.write(f'#define {guard}\n\n')
+    if folded:
+        f.write('// Scaler intégré à la première couche Dense (fold_scaler.py)\n')
+        f.write('#define MODEL_SCALER_FOLDED 1\n\n')
     
     f.write('const unsigned char model_data[] = {\n  ')
     hex_str = binascii.hexlify(model).decode('utf-8')
@@ -45,8 +58,11 @@ with open('model_data.h', 'w') as f:
     
     f.write('\n};\n\n')
     f.write(f'const unsigned int model_data_len = {len(model)};\n\n')
-    f.write('#endif // MODEL_DATA_H\n')
+    f.write('// Alias pour compatibilité\n')
+    f.write('const unsigned char *g_model_data = model_data;\n')
+    f.write('const unsigned int g_model_data_len = sizeof(model_data);\n\n')
+    f.write(f'#endif // {guard}\n')
 
-print(f"✓ Fichier model_data.h créé ({os.path.getsize('model_data.h')/1024:.1f} KB)\n")
+print(f"✓ Fichier {header_file} créé ({os.path.getsize(header_file)/1024:.1f} KB)\n")
 print("CONVERSION RÉUSSIE!")
-print("\nFichier généré: model_data.h")
+print(f"\nFichier généré: {header_file}")
@@ -0,0 +1,175 @@
+import json
+import numpy as np
+import os
+import sys
+
+# Export des features temporelles pour le réentraînement, avec les formules
+# du firmware (TEMPORAL_FEATURE_TABLE, BITalinoEEG_FeatureSet.h), en float32.
+#
+# Entrée : CSV au format "Epileptic Seizure Recognition" (une fenêtre de
+# WINDOW_SIZE = 178 échantillons par ligne, colonnes X1..X178 puis y,
+# y = 1 pour une crise). Les fenêtres doivent être filtrées comme par le
+# préprocesseur (passe-bande EEG) pour que les features coïncident.
+#
+# Sortie :
+#  - epilepsy_features.npz : X (fenêtre puis NUM_SEGMENTS segments, features
+#    du masque dans l'ordre de la table), y, noms, masque, version de table ;
+#  - temporal_features.json : liste relue par extract_scaler.py, qui écrit le
+#    même masque dans feature_set.h.
+#
+# Le sous-ensemble vient de temporal_features.json s'il existe, sinon les
+# 26 features historiques et les 5 features non linéaires (table version 2).
+#
+# Usage: python export_features.py [fichier.csv]
+
+WINDOW_SIZE = 178
+NUM_SEGMENTS = 7
+SEGMENT_SIZE = WINDOW_SIZE // NUM_SEGMENTS  # SEGMENT_REMAINDER_DROP
+
+TEMPORAL_FEATURE_TABLE_VERSION = 2
+
+# Ordre de TEMPORAL_FEATURE_TABLE (voir extract_scaler.py)
+TEMPORAL_FEATURE_NAMES = [
+    'mean', 'median', 'std', 'variance', 'min', 'max', 'range', 'rms',
+    'energy', 'skewness', 'kurtosis', 'zero_crossings', 'entropy',
+    'mean_abs_diff', 'std_abs_diff', 'range_copy', 'coeff_variation',
+    'max_min_ratio', 'abs_mean', 'std_squared', 'rms_abs_mean_ratio',
+    'mean_power', 'half_range', 'abs_mean_abs_diff', 'diff_std_ratio',
+    'zero_crossing_rate',
+    'hjorth_activity', 'hjorth_mobility', 'hjorth_complexity',
+    'line_length', 'tkeo',
+]
+
+
+def temporal_features(x):
+    """Features de TEMPORAL_FEATURE_TABLE pour chaque ligne de x (N × n)"""
+    x = x.astype(np.float32)
+    n = x.shape[1]
+    eps = np.float32(1e-8)
+
+    mean = x.mean(axis=1)
+    dev = x - mean[:, None]
+    variance = (dev ** 2).sum(axis=1) / n
+    std = np.sqrt(variance)
+    x_min = x.min(axis=1)
+    x_max = x.max(axis=1)
+    x_range = x_max - x_min
+    energy = (x ** 2).sum(axis=1)
+    rms = np.sqrt(energy / n)
+
+    safe_std = np.where(std >= eps, std, 1)
+    skewness = np.where(std >= eps, (dev ** 3).sum(axis=1) / safe_std ** 3 / n, 0)
+    kurtosis = np.where(std >= eps, (dev ** 4).sum(axis=1) / safe_std ** 4 / n - 3, 0)
+
+    negative = x < 0
+    zero_crossings = (negative[:, 1:] != negative[:, :-1]).sum(axis=1).astype(np.float32)
+    p = np.abs(x) + eps
+    entropy = -(p * np.log(p)).sum(axis=1)
+
+    diff = np.diff(x, axis=1)
+    abs_diff = np.abs(diff)
+    mean_diff = abs_diff.mean(axis=1)
+    std_diff = np.sqrt(((abs_diff - mean_diff[:, None]) ** 2).sum(axis=1) / (n - 1))
+
+    # Hjorth : puissance des différences (moyenne supposée nulle) sur variance
+    diff_power = (diff ** 2).sum(axis=1) / (n - 1)
+    diff2_power = (np.diff(x, n=2, axis=1) ** 2).sum(axis=1) / (n - 2)
+    mobility = np.sqrt(diff_power / (variance + eps))
+    complexity = np.sqrt(diff2_power / (diff_power + eps)) / (mobility + eps)
+    tkeo = (x[:, 1:-1] ** 2 - x[:, :-2] * x[:, 2:]).sum(axis=1) / (n - 2)
+
+    values = {
+        'mean': mean,
+        'median': np.median(x, axis=1),
+        'std': std,
+        'variance': variance,
+        'min': x_min,
+        'max': x_max,
+        'range': x_range,
+        'rms': rms,
+        'energy': energy,
+        'skewness': skewness,
+        'kurtosis': kurtosis,
+        'zero_crossings': zero_crossings,
+        'entropy': entropy,
+        'mean_abs_diff': mean_diff,
+        'std_abs_diff': std_diff,
+        'range_copy': x_range,
+        'coeff_variation': std / (mean + eps),
+        'max_min_ratio': x_max / (x_min + eps),
+        'abs_mean': np.abs(mean),
+        'std_squared': std * std,
+        'rms_abs_mean_ratio': rms / (np.abs(mean) + eps),
+        'mean_power': energy / n,
+        'half_range': x_range / 2,
+        'abs_mean_abs_diff': np.abs(mean_diff),
+        'diff_std_ratio': std_diff / (std + eps),
+        'zero_crossing_rate': zero_crossings / n,
+        'hjorth_activity': variance,
+        'hjorth_mobility': mobility,
+        'hjorth_complexity': complexity,
+        'line_length': mean_diff,
+        'tkeo': tkeo,
+    }
+    return values
+
+
+def feature_matrix(windows, selected):
+    """Bloc fenêtre puis segments, comme BITalinoEEGPreprocessor::getFeatures()"""
+    ordered = [name for name in TEMPORAL_FEATURE_NAMES if name in selected]
+    blocks = [windows]
+    for seg in range(NUM_SEGMENTS):
+        blocks.append(windows[:, seg * SEGMENT_SIZE:(seg + 1) * SEGMENT_SIZE])
+
+    columns = []
+    for block in blocks:
+        values = temporal_features(block)
+        columns.extend(values[name] for name in ordered)
+    return np.stack(columns, axis=1).astype(np.float32), ordered
+
+
+os.chdir(r'C:\Users\valen\OneDrive\Documents\Projet_IOT')
+
+print("="*70)
+print("EXPORT DES FEATURES POUR LE RÉENTRAÎNEMENT")
+print("="*70)
+
+source = sys.argv[1] if len(sys.argv) >= 2 else 'Epileptic Seizure Recognition.csv'
+if not os.path.exists(source):
+    print(f"\n ERREUR: {source} non trouvé!")
+    exit(1)
+
+selected = TEMPORAL_FEATURE_NAMES
+if os.path.exists('temporal_features.json'):
+    with open('temporal_features.json') as f:
+        selected = json.load(f)
+    unknown = [name for name in selected if name not in TEMPORAL_FEATURE_NAMES]
+    if unknown:
+        print(f"\n ERREUR: features inconnues: {unknown}")
+        exit(1)
+
+raw = np.genfromtxt(source, delimiter=',', skip_header=1, usecols=range(1, WINDOW_SIZE + 2))
+windows = raw[:, :WINDOW_SIZE]
+labels = (raw[:, WINDOW_SIZE] == 1).astype(np.int32)
+print(f"\n✓ {len(windows)} fenêtres chargées ({labels.sum()} crises)")
+
+X, ordered = feature_matrix(windows, selected)
+
+feature_mask = 0
+for name in ordered:
+    feature_mask |= 1 << TEMPORAL_FEATURE_NAMES.index(name)
+
+np.savez('epilepsy_features.npz', X=X, y=labels, feature_names=np.array(ordered),
+         feature_mask=feature_mask, table_version=TEMPORAL_FEATURE_TABLE_VERSION)
+with open('temporal_features.json', 'w') as f:
+    json.dump(ordered, f, indent=2)
+
+print(f"  Features temporelles: {len(ordered)}/{len(TEMPORAL_FEATURE_NAMES)} (masque 0x{feature_mask:X})")
+print(f"  Vecteur: {X.shape[1]} features ({len(ordered)} × {1 + NUM_SEGMENTS} blocs)")
+print("\n  ✓ epilepsy_features.npz")
+print("  ✓ temporal_features.json")
+print("\nProchaine étape:")
+print("  1. Réentraîner le modèle et le scaler sur epilepsy_features.npz")
+print("  2. python extract_scaler.py (scaler_params.h et feature_set.h)")
+print("  3. python convert_model.py")
+print("="*70)
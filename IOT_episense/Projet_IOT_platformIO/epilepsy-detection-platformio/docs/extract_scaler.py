@@ -1,7 +1,23 @@
 import joblib
+import json
 import numpy as np
 import os
 
+# Ordre de TEMPORAL_FEATURE_TABLE (lib/BITalinoEEG_Preprocessor/BITalinoEEG_FeatureSet.h)
+TEMPORAL_FEATURE_NAMES = [
+    'mean', 'median', 'std', 'variance', 'min', 'max', 'range', 'rms',
+    'energy', 'skewness', 'kurtosis', 'zero_crossings', 'entropy',
+    'mean_abs_diff', 'std_abs_diff', 'range_copy', 'coeff_variation',
+    'max_min_ratio', 'abs_mean', 'std_squared', 'rms_abs_mean_ratio',
+    'mean_power', 'half_range', 'abs_mean_abs_diff', 'diff_std_ratio',
+    'zero_crossing_rate',
+    'hjorth_activity', 'hjorth_mobility', 'hjorth_complexity',
+    'line_length', 'tkeo',
+]
+
+# TEMPORAL_FEATURE_TABLE_VERSION (BITalinoEEG_FeatureSet.h)
+TEMPORAL_FEATURE_TABLE_VERSION = 2
+
 os.chdir(r'C:\Users\valen\OneDrive\Documents\Projet_IOT')
 
 print("="*70)
@@ -26,6 +42,22 @@ scaler = joblib.load('scaler.pkl')
 print(f"\n✓ Scaler chargé")
 print(f"  Nombre de features: {len(scaler.mean_)}")
 
+# Sous-ensemble des features temporelles utilisé à l'entraînement (écrit par
+# export_features.py). Sans ce fichier : les 26 features historiques
+selected = TEMPORAL_FEATURE_NAMES[:26]
+if os.path.exists('temporal_features.json'):
+    with open('temporal_features.json') as f:
+        selected = json.load(f)
+    unknown = [name for name in selected if name not in TEMPORAL_FEATURE_NAMES]
+    if unknown:
+        print(f"\n ERREUR: features inconnues: {unknown}")
+        exit(1)
+
+feature_mask = 0
+for name in selected:
+    feature_mask |= 1 << TEMPORAL_FEATURE_NAMES.index(name)
+print(f"  Features temporelles: {len(selected)}/{len(TEMPORAL_FEATURE_NAMES)} (masque 0x{feature_mask:X})")
+
 # Générer le code C
 with open('scaler_params.h', 'w') as f:
     f.write('// Paramètres de normalisation (StandardScaler)\n')
@@ -34,7 +66,8 @@ with open('scaler_params.h', 'w') as f:
     f.write('#ifndef SCALER_PARAMS_H\n')
     f.write('#define SCALER_PARAMS_H\n\n')
     
-    f.write(f'const int NUM_FEATURES = {len(scaler.mean_)};\n\n')
+    f.write(f'const int NUM_FEATURES = {len(scaler.mean_)};\n')
+    f.write(f'#define SCALER_TEMPORAL_FEATURE_MASK 0x{feature_mask:X}u\n\n')
     
     # Moyennes
     f.write('// Moyennes (mean_)\n')
@@ -54,6 +87,17 @@ with open('scaler_params.h', 'w') as f:
     
     f.write('#endif // SCALER_PARAMS_H\n')
 
+# Masque lu par le firmware : seules ces features sont calculées
+with open('feature_set.h', 'w') as f:
+    f.write('// Features temporelles consommées par le modèle (bit i = feature i de\n')
+    f.write('// TEMPORAL_FEATURE_TABLE, voir BITalinoEEG_FeatureSet.h)\n')
+    f.write('// Régénéré par docs/extract_scaler.py avec scaler_params.h\n\n')
+    f.write('#ifndef FEATURE_SET_H\n')
+    f.write('#define FEATURE_SET_H\n\n')
+    f.write(f'#define EEG_TEMPORAL_FEATURE_MASK 0x{feature_mask:X}u\n')
+    f.write(f'#define EEG_TEMPORAL_FEATURE_TABLE_VERSION {TEMPORAL_FEATURE_TABLE_VERSION}\n\n')
+    f.write('#endif // FEATURE_SET_H\n')
+
 print(f"✓ Fichier scaler_params.h créé ({os.path.getsize('scaler_params.h')/1024:.1f} KB)\n")
 
 # Afficher un aperçu
@@ -68,6 +112,7 @@ print("FICHIERS GÉNÉRÉS POUR ARDUINO:")
 print("="*70)
 print("  ✓ model_data.h       (modèle TFLite en C)")
 print("  ✓ scaler_params.h    (paramètres normalisation)")
+print("  ✓ feature_set.h      (masque des features temporelles)")
 print("\nVous pouvez maintenant les utiliser dans Arduino IDE!")
 print("\nProchaine étape:")
 print("  1. Ouvrir Arduino IDE")
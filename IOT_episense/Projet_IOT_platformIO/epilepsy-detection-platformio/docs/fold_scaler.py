@@ -0,0 +1,138 @@
+import joblib
+import numpy as np
+import os
+import tensorflow as tf
+from tensorflow import keras
+
+# Intègre le StandardScaler dans la première couche Dense du modèle :
+#   W·((x − mean) / scale) + b = (W / scale)·x + (b − W·(mean / scale))
+# Le modèle obtenu consomme les features brutes du préprocesseur ; le
+# firmware compilé avec -DEEG_SCALER_FOLDED (env:esp32dev_folded) saute alors
+# la normalisation.
+#
+# L'entrée reste en float32 : les features brutes couvrent 1e-2 à 1e8, une
+# quantification int8 par tenseur de l'entrée les écraserait.
+
+SEUIL_CRISE = 0.7  # SEIZURE_THRESHOLD (src/main.cpp)
+
+os.chdir(r'C:\Users\valen\OneDrive\Documents\Projet_IOT')
+
+print("="*70)
+print("INTÉGRATION DU SCALER DANS LA PREMIÈRE COUCHE DENSE")
+print("="*70)
+
+print(f"\nDossier de travail: {os.getcwd()}")
+
+fichiers_requis = [
+    'epilepsy_model.h5',
+    'scaler.pkl',
+    'epilepsy_data_prepared.npz'
+]
+
+manquants = [f for f in fichiers_requis if not os.path.exists(f)]
+if manquants:
+    print(f"\n ERREUR: fichier(s) manquant(s): {manquants}")
+    exit(1)
+
+model = keras.models.load_model('epilepsy_model.h5')
+scaler = joblib.load('scaler.pkl')
+data = np.load('epilepsy_data_prepared.npz')
+
+print("\n✓ Modèle, scaler et données chargés")
+
+# La couche Dense doit recevoir l'entrée telle quelle (Dropout : identité
+# en inférence). Une convolution partage ses poids entre positions et ne
+# peut pas absorber un scaler par feature.
+dense = None
+for layer in model.layers:
+    if isinstance(layer, keras.layers.Dense):
+        dense = layer
+        break
+    if not isinstance(layer, (keras.layers.InputLayer, keras.layers.Dropout)):
+        print(f"\n ERREUR: couche '{layer.name}' ({type(layer).__name__}) avant la première Dense")
+        exit(1)
+
+if dense is None or not dense.use_bias:
+    print("\n ERREUR: le modèle doit commencer par une couche Dense avec biais")
+    exit(1)
+
+weights = dense.get_weights()
+W = weights[0].astype(np.float64)
+b = weights[1].astype(np.float64)
+
+if W.shape[0] != len(scaler.mean_):
+    print(f"\n ERREUR: {W.shape[0]} entrées pour {len(scaler.mean_)} features du scaler")
+    exit(1)
+
+inv_scale = 1.0 / scaler.scale_
+W_folded = W * inv_scale[:, None]
+b_folded = b - (scaler.mean_ * inv_scale) @ W
+
+folded = keras.models.clone_model(model)
+folded.set_weights(model.get_weights())
+folded.get_layer(dense.name).set_weights(
+    [W_folded.astype(np.float32), b_folded.astype(np.float32)] + weights[2:])
+
+print(f"✓ Couche '{dense.name}' modifiée ({W.shape[0]} × {W.shape[1]})")
+
+# Parité sur le jeu de test : X_test est déjà normalisé, le modèle intégré
+# reçoit les features brutes correspondantes
+X_test = data['X_test']
+y_test = data['y_test']
+X_raw = scaler.inverse_transform(X_test).astype(np.float32)
+
+p_ref = model.predict(X_test, verbose=0).flatten()
+p_folded = folded.predict(X_raw, verbose=0).flatten()
+
+
+def rapport_parite(nom, p):
+    ecart = np.max(np.abs(p - p_ref))
+    diff_05 = np.sum((p > 0.5) != (p_ref > 0.5))
+    diff_seuil = np.sum((p >= SEUIL_CRISE) != (p_ref >= SEUIL_CRISE))
+    accuracy = ((p > 0.5).astype(int) == y_test).mean() * 100
+    print(f"\n{nom}:")
+    print(f"  • Écart max des probabilités: {ecart:.2e}")
+    print(f"  • Décisions différentes (0.5): {diff_05}/{len(p)}")
+    print(f"  • Décisions différentes ({SEUIL_CRISE}): {diff_seuil}/{len(p)}")
+    print(f"  • Accuracy: {accuracy:.2f}%")
+    return diff_05 == 0 and diff_seuil == 0
+
+
+print("\n" + "="*70)
+print("PARITÉ SUR LE JEU DE TEST")
+print("="*70)
+
+ok = rapport_parite("Keras (scaler intégré)", p_folded)
+
+converter = tf.lite.TFLiteConverter.from_keras_model(folded)
+tflite_model = converter.convert()
+
+interpreter = tf.lite.Interpreter(model_content=tflite_model)
+interpreter.allocate_tensors()
+entree = interpreter.get_input_details()[0]
+sortie = interpreter.get_output_details()[0]
+
+p_tflite = np.empty(len(X_raw), dtype=np.float32)
+for i in range(len(X_raw)):
+    interpreter.set_tensor(entree['index'], X_raw[i:i+1])
+    interpreter.invoke()
+    p_tflite[i] = interpreter.get_tensor(sortie['index']).flatten()[0]
+
+ok = rapport_parite("TFLite float32 (scaler intégré)", p_tflite) and ok
+
+if not ok:
+    print("\n ERREUR: prédictions différentes, modèle non écrit")
+    exit(1)
+
+with open('epilepsy_model_folded.tflite', 'wb') as f:
+    f.write(tflite_model)
+
+print(f"\n✓ epilepsy_model_folded.tflite créé ({len(tflite_model)/1024:.2f} KB)")
+
+print("\n" + "="*70)
+print("PROCHAINES ÉTAPES")
+print("="*70)
+print("  1. python convert_model.py epilepsy_model_folded.tflite")
+print("  2. Copier model_data_folded.h dans include/")
+print("  3. pio run -e esp32dev_folded -t upload")
+print("="*70)
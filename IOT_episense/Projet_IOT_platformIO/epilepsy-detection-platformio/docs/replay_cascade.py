@@ -0,0 +1,124 @@
+import json
+import numpy as np
+import os
+import sys
+from tensorflow import keras
+import joblib
+
+# Rejoue le pré-détecteur de la cascade (CascadeGate, BITalinoEEG_Cascade.h)
+# sur le jeu de test et mesure ce que coûte le filtrage en rappel.
+#
+# Longueur de ligne et énergie de la fenêtre sont exactement les features
+# temporelles 'mean_abs_diff' et 'mean_power' du premier bloc (fenêtre
+# entière) : elles sont relues dans X_test dé-normalisé. Le Teager–Kaiser
+# n'est pas une feature du modèle, il n'est pas rejoué ici (seuil ignoré).
+# Les fenêtres du jeu de test sont indépendantes : le contrôle périodique
+# (CASCADE_KEEPALIVE_WINDOWS) n'est pas simulé, le rappel obtenu est donc
+# un minorant.
+#
+# Usage: python replay_cascade.py [seuil_longueur_ligne seuil_energie]
+
+SEUIL_CRISE = 0.7  # SEIZURE_THRESHOLD (src/main.cpp)
+
+# CASCADE_*_THRESHOLD (lib/BITalinoEEG_Preprocessor/BITalinoEEG_Cascade.h)
+SEUIL_LONGUEUR_LIGNE = 20.0
+SEUIL_ENERGIE = 5000.0
+
+# Ordre de TEMPORAL_FEATURE_TABLE (voir extract_scaler.py)
+TEMPORAL_FEATURE_NAMES = [
+    'mean', 'median', 'std', 'variance', 'min', 'max', 'range', 'rms',
+    'energy', 'skewness', 'kurtosis', 'zero_crossings', 'entropy',
+    'mean_abs_diff', 'std_abs_diff', 'range_copy', 'coeff_variation',
+    'max_min_ratio', 'abs_mean', 'std_squared', 'rms_abs_mean_ratio',
+    'mean_power', 'half_range', 'abs_mean_abs_diff', 'diff_std_ratio',
+    'zero_crossing_rate',
+]
+
+if len(sys.argv) >= 3:
+    SEUIL_LONGUEUR_LIGNE = float(sys.argv[1])
+    SEUIL_ENERGIE = float(sys.argv[2])
+
+os.chdir(r'C:\Users\valen\OneDrive\Documents\Projet_IOT')
+
+print("="*70)
+print("REJEU DU PRÉ-DÉTECTEUR (CASCADE)")
+print("="*70)
+
+fichiers_requis = [
+    'epilepsy_model.h5',
+    'scaler.pkl',
+    'epilepsy_data_prepared.npz'
+]
+
+manquants = [f for f in fichiers_requis if not os.path.exists(f)]
+if manquants:
+    print(f"\n ERREUR: fichier(s) manquant(s): {manquants}")
+    exit(1)
+
+model = keras.models.load_model('epilepsy_model.h5')
+scaler = joblib.load('scaler.pkl')
+data = np.load('epilepsy_data_prepared.npz')
+
+print("\n✓ Modèle, scaler et données chargés")
+
+# Position des deux features dans le bloc fenêtre (masque compacté)
+selected = TEMPORAL_FEATURE_NAMES
+if os.path.exists('temporal_features.json'):
+    with open('temporal_features.json') as f:
+        selected = json.load(f)
+selected = [n for n in TEMPORAL_FEATURE_NAMES if n in selected]
+
+for name in ('mean_abs_diff', 'mean_power'):
+    if name not in selected:
+        print(f"\n ERREUR: '{name}' absente des features du modèle, rejeu impossible")
+        exit(1)
+
+X_test = data['X_test']
+y_test = data['y_test']
+X_raw = scaler.inverse_transform(X_test)
+
+longueur_ligne = X_raw[:, selected.index('mean_abs_diff')]
+energie = X_raw[:, selected.index('mean_power')]
+
+p = model.predict(X_test, verbose=0).flatten()
+detecte = p >= SEUIL_CRISE
+crises = y_test == 1
+
+
+def rapport(seuil_ll, seuil_e, afficher=True):
+    suspect = (longueur_ligne >= seuil_ll) | (energie >= seuil_e)
+    rappel_modele = np.sum(detecte & crises) / np.sum(crises) * 100
+    rappel_cascade = np.sum(detecte & suspect & crises) / np.sum(crises) * 100
+    invoque = suspect.mean() * 100
+    invoque_normal = suspect[~crises].mean() * 100
+    if afficher:
+        print(f"\nSeuils: longueur de ligne {seuil_ll:.2f} µV/éch., énergie {seuil_e:.1f} µV²")
+        print(f"  • Fenêtres transmises au réseau: {invoque:.1f}% (normales: {invoque_normal:.1f}%)")
+        print(f"  • Crises transmises: {suspect[crises].mean() * 100:.1f}%")
+        print(f"  • Rappel du modèle seul: {rappel_modele:.2f}%")
+        print(f"  • Rappel de la cascade: {rappel_cascade:.2f}% (coût {rappel_modele - rappel_cascade:.2f} pts)")
+    return rappel_modele - rappel_cascade, invoque
+
+
+print("\n" + "="*70)
+print("SEUILS CONFIGURÉS")
+print("="*70)
+
+rapport(SEUIL_LONGUEUR_LIGNE, SEUIL_ENERGIE)
+
+# Balayage : mêmes quantiles des deux mesures sur les crises détectées
+print("\n" + "="*70)
+print("BALAYAGE (quantiles des crises détectées par le modèle)")
+print("="*70)
+print(f"\n{'quantile':>9} {'long. ligne':>12} {'énergie':>12} {'coût rappel':>12} {'invoqué':>9}")
+
+for q in (0.0, 0.01, 0.02, 0.05, 0.10, 0.20):
+    seuil_ll = np.quantile(longueur_ligne[detecte & crises], q)
+    seuil_e = np.quantile(energie[detecte & crises], q)
+    cout, invoque = rapport(seuil_ll, seuil_e, afficher=False)
+    print(f"{q:>9.2f} {seuil_ll:>12.2f} {seuil_e:>12.1f} {cout:>11.2f}% {invoque:>8.1f}%")
+
+print("\n" + "="*70)
+print("Reporter les seuils retenus dans CASCADE_LINE_LENGTH_THRESHOLD et")
+print("CASCADE_ENERGY_THRESHOLD (build_flags de platformio.ini).")
+print("="*70)
@@ -0,0 +1,10 @@
+// Features temporelles consommées par le modèle (bit i = feature i de
+// TEMPORAL_FEATURE_TABLE, voir BITalinoEEG_FeatureSet.h)
+// Régénéré par docs/extract_scaler.py avec scaler_params.h
+
+#ifndef FEATURE_SET_H
+#define FEATURE_SET_H
+
+#define EEG_TEMPORAL_FEATURE_MASK 0x3FFFFFFu
+
+#endif // FEATURE_SET_H
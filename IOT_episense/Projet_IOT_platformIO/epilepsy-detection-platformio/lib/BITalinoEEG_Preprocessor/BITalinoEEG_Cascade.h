@@ -0,0 +1,183 @@
+/**
+ * @file BITalinoEEG_Cascade.h
+ * @brief Pré-détecteur à seuils devant le réseau de neurones (cascade)
+ *
+ * Trois mesures d'activité de la fenêtre filtrée, quasi gratuites :
+ *  - longueur de ligne moyenne Σ|x[i] − x[i−1]| / (W − 1) (µV/échantillon) ;
+ *  - énergie moyenne Σx² / W (µV²) ;
+ *  - Teager–Kaiser moyen Σ(x[i]² − x[i−1]·x[i+1]) / (W − 2) (µV²).
+ * Les trois sont reprises des statistiques de la passe des features
+ * (abs_diff_sum, sum_sq, tkeo_sum) : le préprocesseur ajoute
+ * CASCADE_WINDOW_STATS à celles du masque. Sans elles (mode incrémental),
+ * le Teager–Kaiser demande une boucle de W multiplications-additions.
+ *
+ * CascadeGate n'autorise l'inférence que si une mesure dépasse son seuil
+ * (fenêtre suspecte), tous les CASCADE_KEEPALIVE_WINDOWS fenêtres (contrôle
+ * périodique), ou si l'appelant la force (crise en cours). Les seuils par
+ * défaut sont à recalibrer avec docs/replay_cascade.py.
+ */
+
+#ifndef BITALINO_EEG_CASCADE_H
+#define BITALINO_EEG_CASCADE_H
+
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_DSP.h"
+#include "BITalinoEEG_Features.h"
+
+#ifndef CASCADE_LINE_LENGTH_THRESHOLD
+#define CASCADE_LINE_LENGTH_THRESHOLD 20.0f
+#endif
+
+#ifndef CASCADE_ENERGY_THRESHOLD
+#define CASCADE_ENERGY_THRESHOLD 5000.0f
+#endif
+
+#ifndef CASCADE_TKEO_THRESHOLD
+#define CASCADE_TKEO_THRESHOLD 500.0f
+#endif
+
+#ifndef CASCADE_KEEPALIVE_WINDOWS
+#define CASCADE_KEEPALIVE_WINDOWS 10
+#endif
+
+// Statistiques de la fenêtre lues par computeWindowActivity()
+#define CASCADE_WINDOW_STATS (STAT_ABS_DIFF | STAT_SUM_SQ | STAT_TKEO)
+
+/**
+ * @brief Mesures d'activité d'une fenêtre
+ */
+struct WindowActivity
+{
+    float line_length;
+    float energy;
+    float tkeo;
+};
+
+/**
+ * @brief Teager–Kaiser moyen d'un segment (length >= 3)
+ */
+inline float meanTeagerKaiser(const float *data, int length)
+{
+    float sum = 0;
+    for (int i = 1; i < length - 1; i++)
+    {
+        sum += data[i] * data[i] - data[i - 1] * data[i + 1];
+    }
+    return sum / (length - 2);
+}
+
+/**
+ * @brief Mesures d'activité de la fenêtre, à partir des statistiques Stats
+ *        de la passe des features quand elles les contiennent
+ */
+template <unsigned Stats>
+inline void computeWindowActivity(const SegmentStats &stats, const float *window, WindowActivity &activity)
+{
+    float abs_diff_sum = stats.abs_diff_sum;
+    if (!(Stats & STAT_ABS_DIFF))
+    {
+        abs_diff_sum = 0;
+        for (int i = 1; i < WINDOW_SIZE; i++)
+            abs_diff_sum += std::abs(window[i] - window[i - 1]);
+    }
+
+    float sum_sq = (Stats & STAT_SUM_SQ) ? stats.sum_sq : dspDotProduct(window, window, WINDOW_SIZE);
+
+    activity.line_length = abs_diff_sum / (WINDOW_SIZE - 1);
+    activity.energy = sum_sq / WINDOW_SIZE;
+    activity.tkeo = (Stats & STAT_TKEO) ? stats.tkeo_sum / (WINDOW_SIZE - 2) : meanTeagerKaiser(window, WINDOW_SIZE);
+}
+
+class CascadeGate
+{
+public:
+    CascadeGate()
+    {
+        setThresholds(CASCADE_LINE_LENGTH_THRESHOLD, CASCADE_ENERGY_THRESHOLD, CASCADE_TKEO_THRESHOLD);
+        setKeepAlive(CASCADE_KEEPALIVE_WINDOWS);
+        reset();
+    }
+
+    void reset()
+    {
+        windows_since_invoke = 0;
+        invoked_windows = 0;
+        suspicious_windows = 0;
+        keepalive_windows = 0;
+        gated_windows = 0;
+    }
+
+    /**
+     * @brief Seuils du pré-détecteur (une mesure au-dessus suffit)
+     */
+    void setThresholds(float line_length, float energy, float tkeo)
+    {
+        line_length_threshold = line_length;
+        energy_threshold = energy;
+        tkeo_threshold = tkeo;
+    }
+
+    /**
+     * @brief Inférence forcée toutes les keepalive fenêtres (0 : jamais)
+     */
+    void setKeepAlive(int windows)
+    {
+        keepalive = windows > 0 ? windows : 0;
+    }
+
+    /**
+     * @brief La fenêtre est-elle suspecte ?
+     */
+    bool isSuspicious(const WindowActivity &activity) const
+    {
+        return activity.line_length >= line_length_threshold ||
+               activity.energy >= energy_threshold ||
+               activity.tkeo >= tkeo_threshold;
+    }
+
+    /**
+     * @brief Décider si le réseau doit être invoqué pour cette fenêtre
+     * @param force true pour invoquer quoi qu'il arrive (crise en cours)
+     */
+    bool shouldInvoke(const WindowActivity &activity, bool force = false)
+    {
+        windows_since_invoke++;
+
+        if (isSuspicious(activity))
+        {
+            suspicious_windows++;
+        }
+        else if (!force && !(keepalive > 0 && windows_since_invoke >= keepalive))
+        {
+            gated_windows++;
+            return false;
+        }
+        else if (!force)
+        {
+            keepalive_windows++;
+        }
+
+        invoked_windows++;
+        windows_since_invoke = 0;
+        return true;
+    }
+
+    unsigned long getInvokedCount() const { return invoked_windows; }
+    unsigned long getSuspiciousCount() const { return suspicious_windows; }
+    unsigned long getKeepAliveCount() const { return keepalive_windows; }
+    unsigned long getGatedCount() const { return gated_windows; }
+
+private:
+    float line_length_threshold;
+    float energy_threshold;
+    float tkeo_threshold;
+    int keepalive;
+
+    int windows_since_invoke;
+    unsigned long invoked_windows;
+    unsigned long suspicious_windows;
+    unsigned long keepalive_windows;
+    unsigned long gated_windows;
+};
+
+#endif
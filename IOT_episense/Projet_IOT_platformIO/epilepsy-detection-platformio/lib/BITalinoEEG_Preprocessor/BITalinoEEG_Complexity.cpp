@@ -0,0 +1,186 @@
+/**
+ * @file BITalinoEEG_Complexity.cpp
+ * @brief Implémentation des entropies par tri et des dimensions fractales
+ *
+ */
+
+#include "BITalinoEEG_Complexity.h"
+#include "BITalinoEEG_FastMath.h"
+#include <cmath>
+#include <stdint.h>
+#include <algorithm>
+
+struct SortedTemplate
+{
+    float key;
+    int16_t index;
+};
+
+// Tampons de travail (pas d'allocation, non réentrant)
+static SortedTemplate sorted_templates[WINDOW_SIZE];
+static uint16_t count_m[WINDOW_SIZE];
+static uint16_t count_m1[WINDOW_SIZE];
+
+static bool templateLess(const SortedTemplate &a, const SortedTemplate &b)
+{
+    return a.key < b.key;
+}
+
+void countEntropyMatches(const float *data, int length, float tolerance, EntropyMatchCounts &counts)
+{
+    const int m = COMPLEXITY_EMBEDDING;
+    const int templates = length - m + 1;
+    const int templates_m1 = length - m;
+
+    for (int i = 0; i < templates; i++)
+    {
+        sorted_templates[i].key = data[i];
+        sorted_templates[i].index = (int16_t)i;
+        count_m[i] = 1;
+        count_m1[i] = 1;
+    }
+    std::sort(sorted_templates, sorted_templates + templates, templateLess);
+
+    long matches_m = 0;
+    long matches_m1 = 0;
+    long candidates = 0;
+
+    for (int p = 0; p < templates; p++)
+    {
+        const float key = sorted_templates[p].key;
+        const int i = sorted_templates[p].index;
+
+        // Première coordonnée à moins de r : suivants dans l'ordre trié
+        for (int q = p + 1; q < templates && sorted_templates[q].key - key <= tolerance; q++)
+        {
+            const int j = sorted_templates[q].index;
+            candidates++;
+
+            bool close = true;
+            for (int k = 1; k < m && close; k++)
+                close = std::abs(data[i + k] - data[j + k]) <= tolerance;
+            if (!close)
+                continue;
+
+            count_m[i]++;
+            count_m[j]++;
+
+            if (i < templates_m1 && j < templates_m1)
+            {
+                matches_m++;
+                if (std::abs(data[i + m] - data[j + m]) <= tolerance)
+                {
+                    matches_m1++;
+                    count_m1[i]++;
+                    count_m1[j]++;
+                }
+            }
+        }
+    }
+
+    float phi_m = 0;
+    for (int i = 0; i < templates; i++)
+        phi_m += eegLog(count_m[i] / (float)templates);
+
+    float phi_m1 = 0;
+    for (int i = 0; i < templates_m1; i++)
+        phi_m1 += eegLog(count_m1[i] / (float)templates_m1);
+
+    counts.matches_m = matches_m;
+    counts.matches_m1 = matches_m1;
+    counts.phi_m = phi_m / templates;
+    counts.phi_m1 = phi_m1 / templates_m1;
+    counts.candidates = candidates;
+}
+
+float katzFractalDimension(const float *data, int length)
+{
+    float line_length = 0;
+    float extent = 0;
+    for (int i = 1; i < length; i++)
+    {
+        line_length += std::abs(data[i] - data[i - 1]);
+        float distance = std::abs(data[i] - data[0]);
+        if (distance > extent)
+            extent = distance;
+    }
+
+    // Signal constant : courbe réduite à un point, dimension d'une droite
+    if (line_length <= 0 || extent <= 0)
+        return 1.0f;
+
+    float log_steps = eegLog((float)(length - 1));
+    return log_steps / (log_steps + eegLog(extent / line_length));
+}
+
+float higuchiFractalDimension(const float *data, int length)
+{
+    float sum_x = 0;
+    float sum_y = 0;
+    float sum_xx = 0;
+    float sum_xy = 0;
+
+    for (int k = 1; k <= COMPLEXITY_HIGUCHI_KMAX; k++)
+    {
+        float curve_length = 0;
+        for (int start = 0; start < k; start++)
+        {
+            int steps = (length - 1 - start) / k;
+            float sum = 0;
+            for (int i = 1; i <= steps; i++)
+                sum += std::abs(data[start + i * k] - data[start + (i - 1) * k]);
+
+            // Normalisation de Higuchi : (N − 1) / (steps · k), puis / k
+            curve_length += sum * (length - 1) / (steps * k) / k;
+        }
+        curve_length /= k;
+
+        if (curve_length <= 0)
+            return 1.0f;
+
+        float x = -eegLog((float)k);
+        float y = eegLog(curve_length);
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    const float n = COMPLEXITY_HIGUCHI_KMAX;
+    return (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+}
+
+void computeComplexityFeatures(const float *window, float *out)
+{
+    float sum = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        sum += window[i];
+    float mean = sum / WINDOW_SIZE;
+
+    float m2 = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        float d = window[i] - mean;
+        m2 += d * d;
+    }
+    float tolerance = COMPLEXITY_TOLERANCE * eegSqrt(m2 / WINDOW_SIZE);
+
+    EntropyMatchCounts counts;
+    countEntropyMatches(window, WINDOW_SIZE, tolerance, counts);
+
+    float sample_entropy;
+    if (counts.matches_m > 0 && counts.matches_m1 > 0)
+    {
+        sample_entropy = eegLog((float)counts.matches_m) - eegLog((float)counts.matches_m1);
+    }
+    else
+    {
+        const int templates = WINDOW_SIZE - COMPLEXITY_EMBEDDING;
+        sample_entropy = eegLog(templates * (templates - 1) / 2.0f);
+    }
+
+    out[0] = sample_entropy;
+    out[1] = counts.phi_m - counts.phi_m1;
+    out[2] = katzFractalDimension(window, WINDOW_SIZE);
+    out[3] = higuchiFractalDimension(window, WINDOW_SIZE);
+}
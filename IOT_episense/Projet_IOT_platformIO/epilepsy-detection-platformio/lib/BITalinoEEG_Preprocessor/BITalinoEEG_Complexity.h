@@ -0,0 +1,90 @@
+/**
+ * @file BITalinoEEG_Complexity.h
+ * @brief Features de complexité de la fenêtre : entropies d'échantillon et
+ *        approchée, dimensions fractales de Katz et de Higuchi
+ *
+ * Entropies (Richman & Moorman, Pincus), dimension d'immersion
+ * COMPLEXITY_EMBEDDING = m, tolérance r = COMPLEXITY_TOLERANCE · écart-type de
+ * la fenêtre, distance de Tchebychev entre vecteurs (x[i], …, x[i+m−1]) :
+ *  - SampEn = −ln(A / B), B (resp. A) paires i < j de vecteurs de longueur m
+ *    (resp. m + 1) à distance ≤ r, parmi les N − m premiers vecteurs ;
+ *  - ApEn = Φm − Φm+1, Φk = moyenne de ln(Ci / (N − k + 1)), Ci nombre de
+ *    vecteurs de longueur k à distance ≤ r du i-ème (lui compris).
+ * Les deux se déduisent des mêmes paires. Sans paire (A ou B nul), SampEn
+ * prend sa borne ln(B_max) = ln((N − m)(N − m − 1) / 2).
+ *
+ * Énumération : au lieu des (N − m + 1)(N − m) / 2 paires, les vecteurs sont
+ * triés sur leur première coordonnée (tri en place, sans tas) ; pour chacun,
+ * on ne parcourt que les suivants dans l'ordre trié tant que l'écart sur
+ * cette coordonnée reste ≤ r. Coût O(N log N + P), P paires candidates :
+ * ~0.11 · N² / 2 pour un signal gaussien (r = 0.2σ), contre N² / 2. Le pire
+ * cas (toutes les valeurs à moins de r, par exemple un signal plat) revient à
+ * P = (N − m + 1)(N − m) / 2 = COMPLEXITY_MAX_PAIRS : le coût est borné par
+ * construction, WINDOW_SIZE étant fixe.
+ *
+ * Katz : FD = log(N − 1) / (log(N − 1) + log(d / L)), L longueur de ligne
+ * Σ|x[i] − x[i−1]|, d = max|x[i] − x[0]|.
+ * Higuchi : pente de log L(k) contre log(1/k), k = 1..COMPLEXITY_HIGUCHI_KMAX,
+ * L(k) longueur moyenne des k sous-séries de pas k. Coût N · kmax.
+ *
+ * Features (NUM_COMPLEXITY_FEATURES) :
+ *  0  entropie d'échantillon (SampEn)
+ *  1  entropie approchée (ApEn)
+ *  2  dimension fractale de Katz
+ *  3  dimension fractale de Higuchi
+ */
+
+#ifndef BITALINO_EEG_COMPLEXITY_H
+#define BITALINO_EEG_COMPLEXITY_H
+
+#include "BITalinoEEG_Config.h"
+
+#define COMPLEXITY_EMBEDDING 2
+#define COMPLEXITY_TOLERANCE 0.2f
+#define COMPLEXITY_HIGUCHI_KMAX 8
+#define NUM_COMPLEXITY_FEATURES 4
+
+// Paires de vecteurs de longueur m examinées au pire (énumération complète)
+#define COMPLEXITY_MAX_PAIRS \
+    ((WINDOW_SIZE - COMPLEXITY_EMBEDDING + 1) * (WINDOW_SIZE - COMPLEXITY_EMBEDDING) / 2)
+
+/**
+ * @brief Décomptes de paires communs à SampEn et ApEn
+ */
+struct EntropyMatchCounts
+{
+    long matches_m;  // B : paires i < j < N − m à distance ≤ r (longueur m)
+    long matches_m1; // A : mêmes paires à distance ≤ r en longueur m + 1
+    float phi_m;     // Φm (ApEn)
+    float phi_m1;    // Φm+1 (ApEn)
+    long candidates; // Paires candidates examinées (≤ COMPLEXITY_MAX_PAIRS)
+};
+
+/**
+ * @brief Décompter les paires de vecteurs proches par tri (voir l'en-tête)
+ * @param data length échantillons (COMPLEXITY_EMBEDDING + 2 à WINDOW_SIZE)
+ * @param tolerance r (µV)
+ * @param counts Décomptes de sortie
+ */
+void countEntropyMatches(const float *data, int length, float tolerance, EntropyMatchCounts &counts);
+
+/**
+ * @brief Dimension fractale de Katz
+ */
+float katzFractalDimension(const float *data, int length);
+
+/**
+ * @brief Dimension fractale de Higuchi (k = 1..COMPLEXITY_HIGUCHI_KMAX)
+ * @param length Au moins 2 · COMPLEXITY_HIGUCHI_KMAX échantillons
+ */
+float higuchiFractalDimension(const float *data, int length);
+
+/**
+ * @brief Calculer les NUM_COMPLEXITY_FEATURES features de complexité
+ *        (tampons de travail statiques, non réentrant)
+ * @param window WINDOW_SIZE échantillons filtrés
+ * @param out Tableau de sortie
+ */
+void computeComplexityFeatures(const float *window, float *out);
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file BITalinoEEG_Config.h
+ * @brief Géométrie de la fenêtre d'analyse EEG (partagée par tous les étages)
+ *
+ */
+
+#ifndef BITALINO_EEG_CONFIG_H
+#define BITALINO_EEG_CONFIG_H
+
+#define SAMPLE_RATE 178
+#define WINDOW_SIZE 178
+#define OVERLAP_PERCENTAGE 50
+#define OVERLAP_SIZE (WINDOW_SIZE * OVERLAP_PERCENTAGE / 100)
+#define HOP_SIZE (WINDOW_SIZE - OVERLAP_SIZE)
+#define NUM_SEGMENTS 7
+#define SEGMENT_SIZE (WINDOW_SIZE / NUM_SEGMENTS)
+
+// Taille des blocs internes de addSamples() (tampons sur la pile)
+#define INGEST_BLOCK_SIZE 32
+
+// Passe-bande EEG, calculé par BITalinoEEG_FilterDesign.h. Le passe-bas
+// reproduit à 0.3 dB près (jusqu'à 45 Hz) l'ancien filtre codé en dur, gain
+// de bande passante compris : le scaler et le modèle ont été ajustés sur ces
+// amplitudes.
+#define EEG_HIGHPASS_HZ 0.5
+#define EEG_HIGHPASS_ORDER 4
+#define EEG_LOWPASS_HZ 22.4
+#define EEG_LOWPASS_ORDER 4
+#define EEG_BANDPASS_GAIN 1.944
+
+// Réjecteur secteur : 50 Hz (Europe) ou 60 Hz (Amériques), 0 pour le désactiver
+#ifndef EEG_MAINS_FREQUENCY
+#define EEG_MAINS_FREQUENCY 50
+#endif
+#define EEG_NOTCH_Q 30
+
+// Entrées analogiques du BITalino (A1..A6)
+#define BITALINO_NUM_ANALOG_CHANNELS 6
+
+// Fonction de transfert du capteur EEG BITalino
+#define BITALINO_ADC_RESOLUTION 1024.0f
+#define BITALINO_VCC 3.3f
+#define EEG_VCC_HALF 1.65f
+#define EEG_GAIN 1000.0f
+
+/**
+ * @brief Convertir une valeur ADC (0-1023) en µV (chaîne float)
+ */
+inline float adcToMicrovolts(int adc_value)
+{
+    float voltage = ((float)adc_value / BITALINO_ADC_RESOLUTION) * BITALINO_VCC;
+
+    float eeg_voltage = (voltage - EEG_VCC_HALF) / EEG_GAIN;
+
+    return eeg_voltage * 1e6;
+}
+
+#endif
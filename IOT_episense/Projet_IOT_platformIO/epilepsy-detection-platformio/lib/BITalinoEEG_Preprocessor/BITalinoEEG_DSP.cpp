@@ -0,0 +1,128 @@
+/**
+ * @file BITalinoEEG_DSP.cpp
+ * @brief Implémentations de référence et routage vers ESP-DSP
+ *
+ */
+
+#include "BITalinoEEG_DSP.h"
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_Filters.h"
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+#include "esp_dsp.h"
+#endif
+
+float dspSumReference(const float *x, int n)
+{
+    float sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        sum += x[i];
+    }
+    return sum;
+}
+
+float dspDotProductReference(const float *a, const float *b, int n)
+{
+    float sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void dspAddConstantReference(const float *in, float *out, int n, float c)
+{
+    for (int i = 0; i < n; i++)
+    {
+        out[i] = in[i] + c;
+    }
+}
+
+// Même ordre d'opérations que dsps_biquad_f32_ansi
+void dspBiquadReference(const float *in, float *out, int n, const BiquadCoefficients &c, float *state)
+{
+    for (int i = 0; i < n; i++)
+    {
+        float d0 = in[i] - c.a1 * state[0] - c.a2 * state[1];
+        out[i] = c.b0 * d0 + c.b1 * state[0] + c.b2 * state[1];
+        state[1] = state[0];
+        state[0] = d0;
+    }
+}
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+
+static_assert(sizeof(BiquadCoefficients) == 5 * sizeof(float),
+              "dsps_biquad_f32 attend 5 coefficients contigus");
+
+// ESP-DSP n'a pas de somme : produit scalaire avec un vecteur de uns
+static float ones[WINDOW_SIZE];
+static bool ones_ready = false;
+
+float dspSum(const float *x, int n)
+{
+    if (!ones_ready)
+    {
+        for (int i = 0; i < WINDOW_SIZE; i++)
+        {
+            ones[i] = 1.0f;
+        }
+        ones_ready = true;
+    }
+
+    float sum = 0;
+    while (n > 0)
+    {
+        int run = n < WINDOW_SIZE ? n : WINDOW_SIZE;
+        float partial;
+        dsps_dotprod_f32(x, ones, &partial, run);
+        sum += partial;
+        x += run;
+        n -= run;
+    }
+    return sum;
+}
+
+float dspDotProduct(const float *a, const float *b, int n)
+{
+    float result;
+    dsps_dotprod_f32(a, b, &result, n);
+    return result;
+}
+
+void dspAddConstant(const float *in, float *out, int n, float c)
+{
+    dsps_addc_f32(in, out, n, c, 1, 1);
+}
+
+void dspBiquad(const float *in, float *out, int n, const BiquadCoefficients &c, float *state)
+{
+    // Les 5 coefficients sont contigus dans l'ordre attendu {b0, b1, b2, a1, a2}
+    dsps_biquad_f32(in, out, n, const_cast<float *>(&c.b0), state);
+}
+
+#else
+
+float dspSum(const float *x, int n)
+{
+    return dspSumReference(x, n);
+}
+
+float dspDotProduct(const float *a, const float *b, int n)
+{
+    return dspDotProductReference(a, b, n);
+}
+
+void dspAddConstant(const float *in, float *out, int n, float c)
+{
+    dspAddConstantReference(in, out, n, c);
+}
+
+void dspBiquad(const float *in, float *out, int n, const BiquadCoefficients &c, float *state)
+{
+    dspBiquadReference(in, out, n, c, state);
+}
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file BITalinoEEG_DSP.h
+ * @brief Primitives DSP vectorielles avec backend sélectionnable
+ *
+ * Backend choisi à la compilation :
+ *  - référence (défaut) : boucles C++ portables, compilées sur l'hôte ;
+ *  - ESP-DSP (-DEEG_DSP_BACKEND_ESPDSP, voir env:esp32dev_espdsp) : routines
+ *    optimisées d'Espressif (dsps_dotprod_f32, dsps_biquad_f32, dsps_addc_f32).
+ *
+ * Les implémentations de référence (suffixe Reference) sont toujours
+ * compilées : elles servent d'oracle aux tests et de point de comparaison
+ * aux benchmarks par noyau, y compris sur la carte.
+ *
+ * Les biquads suivent la convention d'état d'ESP-DSP (forme directe II,
+ * w[0] = d[n-1], w[1] = d[n-2]) et le tableau de coefficients
+ * {b0, b1, b2, a1, a2}, identique à la disposition de BiquadCoefficients.
+ *
+ * Le passe-bande (BiquadCascade) reste en forme directe II transposée quel
+ * que soit le backend : en forme directe II float, l'état interne des
+ * sections du passe-haut à 0.5 Hz vaut ~2·10^4 fois le signal
+ * (1 / (1 + a1 + a2)) et un échelon DC de 1000 µV laisse un résidu de
+ * ~0.2 µV au lieu de < 0.01 µV. dspBiquad est donc réservé aux sections
+ * bien conditionnées (passe-bas, futurs étages) et au benchmark.
+ */
+
+#ifndef BITALINO_EEG_DSP_H
+#define BITALINO_EEG_DSP_H
+
+struct BiquadCoefficients;
+
+#if defined(EEG_DSP_BACKEND_ESPDSP) && !defined(ESP_PLATFORM)
+#error "EEG_DSP_BACKEND_ESPDSP nécessite une cible ESP32 (ESP-DSP)"
+#endif
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+#define EEG_DSP_BACKEND_NAME "esp-dsp"
+#else
+#define EEG_DSP_BACKEND_NAME "reference"
+#endif
+
+/**
+ * @brief Somme des n éléments de x
+ */
+float dspSum(const float *x, int n);
+
+/**
+ * @brief Produit scalaire Σ a[i]·b[i] (énergie si a == b)
+ */
+float dspDotProduct(const float *a, const float *b, int n);
+
+/**
+ * @brief out[i] = in[i] + c (in et out peuvent être égaux)
+ */
+void dspAddConstant(const float *in, float *out, int n, float c);
+
+/**
+ * @brief Filtrer un bloc par une section biquad en forme directe II
+ * @param state État w[2] de la section (convention ESP-DSP)
+ */
+void dspBiquad(const float *in, float *out, int n, const BiquadCoefficients &c, float *state);
+
+float dspSumReference(const float *x, int n);
+float dspDotProductReference(const float *a, const float *b, int n);
+void dspAddConstantReference(const float *in, float *out, int n, float c);
+void dspBiquadReference(const float *in, float *out, int n, const BiquadCoefficients &c, float *state);
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file BITalinoEEG_FastMath.h
+ * @brief log / sqrt rapides pour les features (sans branche ni table)
+ *
+ * fastLog : x = 2^e·m avec m ∈ [2/3, 4/3) obtenu par manipulation des bits,
+ * puis ln(1 + f) = f + f²·P(f), P de degré 7 (interpolation de Tchebychev sur
+ * [−1/3, 1/3]). Erreur mesurée sur [1e-8, 2e4] : relative ≤ 1.6e-7 hors de
+ * |ln x| < 1e-3, absolue ≤ 2e-6 (arrondi de e·ln2 pour |e| grand). Domaine :
+ * flottants positifs normalisés (p ≥ 1e-8 dans l'entropie).
+ *
+ * fastSqrt : racine inverse par constante magique + 3 itérations de Newton,
+ * puis x·r. Erreur relative ≤ 2e-7 ; fastSqrt(0) = 0.
+ *
+ * Les deux noyaux sont des suites de multiplications-additions sans branche :
+ * une boucle qui les appelle reste déroulable et pipelinable.
+ *
+ * EEG_FAST_MATH (défaut 1) route eegLog / eegSqrt vers ces noyaux ;
+ * -DEEG_FAST_MATH=0 revient à libm pour la validation.
+ */
+
+#ifndef BITALINO_EEG_FASTMATH_H
+#define BITALINO_EEG_FASTMATH_H
+
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+#ifndef EEG_FAST_MATH
+#define EEG_FAST_MATH 1
+#endif
+
+#define FAST_LOG_LN2 0.693147180559945f
+
+inline float fastLog(float x)
+{
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    // Exposant choisi pour que la mantisse tombe dans [2/3, 4/3)
+    int32_t exponent = (bits - 0x3f2aaaab) & ~0x7fffff;
+    int32_t mantissa_bits = bits - exponent;
+    float m;
+    memcpy(&m, &mantissa_bits, sizeof(m));
+
+    float f = m - 1.0f;
+    float p = 1.342574901e-01f;
+    p = p * f - 1.504076372e-01f;
+    p = p * f + 1.411830990e-01f;
+    p = p * f - 1.648301753e-01f;
+    p = p * f + 2.000378032e-01f;
+    p = p * f - 2.500414619e-01f;
+    p = p * f + 3.333332017e-01f;
+    p = p * f - 4.999998556e-01f;
+
+    return (float)(exponent / (1 << 23)) * FAST_LOG_LN2 + (f + f * f * p);
+}
+
+inline float fastSqrt(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f375a86 - (bits >> 1);
+    float r;
+    memcpy(&r, &bits, sizeof(r));
+
+    float half = 0.5f * x;
+    r = r * (1.5f - half * r * r);
+    r = r * (1.5f - half * r * r);
+    r = r * (1.5f - half * r * r);
+
+    return x * r;
+}
+
+inline float eegLog(float x)
+{
+#if EEG_FAST_MATH
+    return fastLog(x);
+#else
+    return std::log(x);
+#endif
+}
+
+inline float eegSqrt(float x)
+{
+#if EEG_FAST_MATH
+    return fastSqrt(x);
+#else
+    return std::sqrt(x);
+#endif
+}
+
+#endif
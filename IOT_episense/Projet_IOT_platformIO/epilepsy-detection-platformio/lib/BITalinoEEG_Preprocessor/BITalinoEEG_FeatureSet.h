@@ -0,0 +1,451 @@
+/**
+ * @file BITalinoEEG_FeatureSet.h
+ * @brief Descripteur des features temporelles et extracteur généré par masque
+ *
+ * TEMPORAL_FEATURE_TABLE nomme chaque feature, les statistiques dont elle
+ * dépend (drapeaux STAT_*) et, pour les doublons, la feature dont elle est
+ * la copie. Un masque (bit i = feature i) sélectionne les features
+ * consommées par le modèle ; TemporalFeatureSet<Mask> en déduit à la
+ * compilation :
+ *  - les statistiques à calculer (les autres passes disparaissent, la
+ *    médiane par exemple n'est plus calculée si aucune feature ne l'utilise) ;
+ *  - la position de chaque feature retenue dans le bloc de sortie compacté.
+ *
+ * Le masque du préprocesseur est EEG_TEMPORAL_FEATURE_MASK, écrit dans
+ * include/feature_set.h par docs/extract_scaler.py avec les paramètres du
+ * scaler : réentraîner sur un sous-ensemble réduit suffit à alléger le
+ * firmware.
+ *
+ * Doublons : 15 = 6 (étendue), 23 = 13 (|mean_diff| avec mean_diff ≥ 0),
+ * 19 = 3 à l'arrondi près (std² contre variance). Ils restent calculés
+ * tant qu'ils sont dans le masque, pour ne pas changer le format existant ;
+ * TEMPORAL_FEATURE_MASK_UNIQUE les exclut.
+ *
+ * Version 2 de la table : 5 features non linéaires (bits 26 à 30,
+ * TEMPORAL_FEATURE_MASK_NONLINEAR), hors du masque par défaut :
+ *  - hjorth_activity : variance (= 3) ;
+ *  - hjorth_mobility : √(P' / variance), P' = Σ(x[i] − x[i−1])² / (n − 1) ;
+ *  - hjorth_complexity : √(P'' / P') / mobilité, P'' puissance des
+ *    différences secondes ;
+ *  - line_length : Σ|x[i] − x[i−1]| / (n − 1) (= 13) ;
+ *  - tkeo : Teager–Kaiser moyen Σ(x[i]² − x[i−1]·x[i+1]) / (n − 2).
+ * P' n'a pas d'accumulateur propre : c'est std_diff² + mean_diff², tiré des
+ * statistiques des features 13 et 14. Seuls P'' et le Teager–Kaiser
+ * s'ajoutent à la passe 1. Les dérivées sont supposées de moyenne nulle
+ * (signal passe-bande) : P' et P'' remplacent leurs variances.
+ *
+ * computeWindow() produit le bloc fenêtre + segments en un seul parcours :
+ * les statistiques de la fenêtre sont fusionnées depuis celles des segments.
+ * Le découpage est le paramètre Geometry (BITalinoEEG_Geometry.h) : chaque
+ * segment est traité par un noyau de longueur constante.
+ */
+
+#ifndef BITALINO_EEG_FEATURESET_H
+#define BITALINO_EEG_FEATURESET_H
+
+#include <cmath>
+#include <stdint.h>
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_Moments.h"
+#include "BITalinoEEG_Geometry.h"
+
+#define NUM_NONLINEAR_FEATURES 5
+#define TEMPORAL_FEATURE_TABLE_SIZE (NUM_TEMPORAL_FEATURES + NUM_NONLINEAR_FEATURES)
+
+// Version de TEMPORAL_FEATURE_TABLE (les masques d'une version restent valides
+// dans les suivantes : les features sont ajoutées à la fin)
+//  1 : 26 features historiques
+//  2 : + 5 features non linéaires (Hjorth, longueur de ligne, Teager–Kaiser)
+#define TEMPORAL_FEATURE_TABLE_VERSION 2
+
+// 26 features historiques (layout d'origine du modèle)
+#define TEMPORAL_FEATURE_MASK_ALL ((1u << NUM_TEMPORAL_FEATURES) - 1)
+#define TEMPORAL_FEATURE_MASK_NONLINEAR (((1u << TEMPORAL_FEATURE_TABLE_SIZE) - 1) & ~TEMPORAL_FEATURE_MASK_ALL)
+#define TEMPORAL_FEATURE_MASK_EXTENDED (TEMPORAL_FEATURE_MASK_ALL | TEMPORAL_FEATURE_MASK_NONLINEAR)
+
+/**
+ * @brief Description d'une feature temporelle
+ */
+struct TemporalFeatureDescriptor
+{
+    const char *name;
+    unsigned stats;
+    int alias_of;
+};
+
+constexpr TemporalFeatureDescriptor TEMPORAL_FEATURE_TABLE[TEMPORAL_FEATURE_TABLE_SIZE] = {
+    {"mean", STAT_SUM, -1},
+    {"median", STAT_MEDIAN, -1},
+    {"std", STAT_M2, -1},
+    {"variance", STAT_M2, -1},
+    {"min", STAT_MIN_MAX, -1},
+    {"max", STAT_MIN_MAX, -1},
+    {"range", STAT_MIN_MAX, -1},
+    {"rms", STAT_SUM_SQ, -1},
+    {"energy", STAT_SUM_SQ, -1},
+    {"skewness", STAT_M2 | STAT_M34, -1},
+    {"kurtosis", STAT_M2 | STAT_M34, -1},
+    {"zero_crossings", STAT_ZERO_CROSSINGS, -1},
+    {"entropy", STAT_ENTROPY, -1},
+    {"mean_abs_diff", STAT_ABS_DIFF, -1},
+    {"std_abs_diff", STAT_ABS_DIFF | STAT_ABS_DIFF_DEV, -1},
+    {"range_copy", STAT_MIN_MAX, 6},
+    {"coeff_variation", STAT_SUM | STAT_M2, -1},
+    {"max_min_ratio", STAT_MIN_MAX, -1},
+    {"abs_mean", STAT_SUM, -1},
+    {"std_squared", STAT_M2, 3},
+    {"rms_abs_mean_ratio", STAT_SUM | STAT_SUM_SQ, -1},
+    {"mean_power", STAT_SUM_SQ, -1},
+    {"half_range", STAT_MIN_MAX, -1},
+    {"abs_mean_abs_diff", STAT_ABS_DIFF, 13},
+    {"diff_std_ratio", STAT_M2 | STAT_ABS_DIFF | STAT_ABS_DIFF_DEV, -1},
+    {"zero_crossing_rate", STAT_ZERO_CROSSINGS, -1},
+    {"hjorth_activity", STAT_M2, 3},
+    {"hjorth_mobility", STAT_M2 | STAT_ABS_DIFF | STAT_ABS_DIFF_DEV, -1},
+    {"hjorth_complexity", STAT_M2 | STAT_ABS_DIFF | STAT_ABS_DIFF_DEV | STAT_DIFF2_SQ, -1},
+    {"line_length", STAT_ABS_DIFF, 13},
+    {"tkeo", STAT_TKEO, -1},
+};
+
+/**
+ * @brief Statistiques requises par un masque, dépendances fermées
+ * @param extra Statistiques demandées en plus, sans feature émise
+ */
+constexpr unsigned temporalFeatureStats(uint32_t mask, unsigned extra = 0)
+{
+    unsigned stats = extra;
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        if (mask & (1u << i))
+            stats |= TEMPORAL_FEATURE_TABLE[i].stats;
+    }
+    if (stats & (STAT_M2 | STAT_M34))
+        stats |= STAT_SUM | STAT_M2;
+    if (stats & STAT_ABS_DIFF_DEV)
+        stats |= STAT_ABS_DIFF;
+    return stats;
+}
+
+/**
+ * @brief Nombre de features retenues par un masque
+ */
+constexpr int temporalFeatureCount(uint32_t mask)
+{
+    int count = 0;
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        if (mask & (1u << i))
+            count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Masque sans les doublons de la table
+ */
+constexpr uint32_t temporalFeatureUniqueMask()
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        if (TEMPORAL_FEATURE_TABLE[i].alias_of < 0)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief Cohérence de la table : un doublon désigne une feature antérieure
+ *        non dupliquée, avec les mêmes dépendances
+ */
+constexpr bool temporalFeatureTableValid()
+{
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        int alias = TEMPORAL_FEATURE_TABLE[i].alias_of;
+        if (alias >= i || (alias >= 0 && (TEMPORAL_FEATURE_TABLE[alias].alias_of >= 0 ||
+                                          TEMPORAL_FEATURE_TABLE[alias].stats != TEMPORAL_FEATURE_TABLE[i].stats)))
+            return false;
+    }
+    return true;
+}
+
+static_assert(temporalFeatureTableValid(), "TEMPORAL_FEATURE_TABLE : doublon invalide");
+
+#define TEMPORAL_FEATURE_MASK_UNIQUE (temporalFeatureUniqueMask())
+
+/**
+ * @brief Grandeurs intermédiaires partagées par plusieurs features
+ *
+ * Seules celles couvertes par Stats sont calculées (branches constantes).
+ */
+struct TemporalFeatureValues
+{
+    const SegmentStats *stats;
+    float mean_val;
+    float variance;
+    float std_val;
+    float range;
+    float rms;
+    float mean_diff;
+    float std_diff;
+    float skewness;
+    float kurtosis;
+    float mobility;
+    float complexity;
+};
+
+template <unsigned Stats>
+inline void deriveTemporalFeatureValues(const SegmentStats &stats, TemporalFeatureValues &v)
+{
+    int length = stats.length;
+
+    v.stats = &stats;
+    v.mean_val = (Stats & STAT_SUM) ? stats.sum / length : 0;
+    v.variance = (Stats & STAT_M2) ? stats.m2 / length : 0;
+    v.std_val = (Stats & STAT_M2) ? eegSqrt(v.variance) : 0;
+    v.range = stats.max - stats.min;
+    v.rms = (Stats & STAT_SUM_SQ) ? eegSqrt(stats.sum_sq / length) : 0;
+    v.mean_diff = stats.abs_diff_sum / (length - 1);
+    v.std_diff = (Stats & STAT_ABS_DIFF_DEV) ? eegSqrt(stats.abs_diff_dev_sq / (length - 1)) : 0;
+
+    v.skewness = 0.0f;
+    v.kurtosis = 0.0f;
+    if ((Stats & STAT_M34) && v.std_val >= 1e-8)
+    {
+        float std_sq = v.std_val * v.std_val;
+        v.skewness = (stats.m3 / (std_sq * v.std_val)) / length;
+        v.kurtosis = (stats.m4 / (std_sq * std_sq)) / length - 3.0f;
+    }
+
+    // Hjorth : P' = std_diff² + mean_diff² (accumulateurs des features 13 et 14)
+    const unsigned hjorth_stats = STAT_M2 | STAT_ABS_DIFF_DEV;
+    float diff_power = 0;
+    v.mobility = 0;
+    v.complexity = 0;
+    if ((Stats & hjorth_stats) == hjorth_stats)
+    {
+        diff_power = stats.abs_diff_dev_sq / (length - 1) + v.mean_diff * v.mean_diff;
+        v.mobility = eegSqrt(diff_power / (v.variance + 1e-8));
+    }
+    if ((Stats & (hjorth_stats | STAT_DIFF2_SQ)) == (hjorth_stats | STAT_DIFF2_SQ))
+    {
+        float diff2_power = stats.diff2_sq_sum / (length > 2 ? length - 2 : 1);
+        v.complexity = eegSqrt(diff2_power / (diff_power + 1e-8)) / (v.mobility + 1e-8);
+    }
+}
+
+/**
+ * @brief Valeur de la feature Feature (indice de TEMPORAL_FEATURE_TABLE)
+ */
+template <int Feature>
+float temporalFeatureValue(const TemporalFeatureValues &v);
+
+#define TEMPORAL_FEATURE_VALUE(index, expression)                             \
+    template <>                                                               \
+    inline float temporalFeatureValue<index>(const TemporalFeatureValues &v) \
+    {                                                                         \
+        return expression;                                                    \
+    }
+
+TEMPORAL_FEATURE_VALUE(0, v.mean_val)
+TEMPORAL_FEATURE_VALUE(1, v.stats->median)
+TEMPORAL_FEATURE_VALUE(2, v.std_val)
+TEMPORAL_FEATURE_VALUE(3, v.variance)
+TEMPORAL_FEATURE_VALUE(4, v.stats->min)
+TEMPORAL_FEATURE_VALUE(5, v.stats->max)
+TEMPORAL_FEATURE_VALUE(6, v.range)
+TEMPORAL_FEATURE_VALUE(7, v.rms)
+TEMPORAL_FEATURE_VALUE(8, v.stats->sum_sq)
+TEMPORAL_FEATURE_VALUE(9, v.skewness)
+TEMPORAL_FEATURE_VALUE(10, v.kurtosis)
+TEMPORAL_FEATURE_VALUE(11, v.stats->zero_crossings)
+TEMPORAL_FEATURE_VALUE(12, -v.stats->entropy_sum)
+TEMPORAL_FEATURE_VALUE(13, v.mean_diff)
+TEMPORAL_FEATURE_VALUE(14, v.std_diff)
+TEMPORAL_FEATURE_VALUE(15, v.range)
+TEMPORAL_FEATURE_VALUE(16, v.std_val / (v.mean_val + 1e-8))
+TEMPORAL_FEATURE_VALUE(17, v.stats->max / (v.stats->min + 1e-8))
+TEMPORAL_FEATURE_VALUE(18, std::abs(v.mean_val))
+TEMPORAL_FEATURE_VALUE(19, v.std_val * v.std_val)
+TEMPORAL_FEATURE_VALUE(20, v.rms / (std::abs(v.mean_val) + 1e-8))
+TEMPORAL_FEATURE_VALUE(21, v.stats->sum_sq / v.stats->length)
+TEMPORAL_FEATURE_VALUE(22, v.range / 2.0f)
+TEMPORAL_FEATURE_VALUE(23, std::abs(v.mean_diff))
+TEMPORAL_FEATURE_VALUE(24, v.std_diff / (v.std_val + 1e-8))
+TEMPORAL_FEATURE_VALUE(25, v.stats->zero_crossings / (float)v.stats->length)
+TEMPORAL_FEATURE_VALUE(26, v.variance)
+TEMPORAL_FEATURE_VALUE(27, v.mobility)
+TEMPORAL_FEATURE_VALUE(28, v.complexity)
+TEMPORAL_FEATURE_VALUE(29, v.mean_diff)
+TEMPORAL_FEATURE_VALUE(30, v.stats->tkeo_sum / (v.stats->length > 2 ? v.stats->length - 2 : 1))
+
+#undef TEMPORAL_FEATURE_VALUE
+
+/**
+ * @brief Écriture des features retenues, Out = position de sortie de Feature
+ */
+template <uint32_t Mask, int Feature, int Out>
+struct TemporalFeatureWriter
+{
+    static const bool Selected = (Mask >> Feature) & 1u;
+
+    static void write(const TemporalFeatureValues &v, float *out)
+    {
+        if (Selected)
+            out[Out] = temporalFeatureValue<Feature>(v);
+        TemporalFeatureWriter<Mask, Feature + 1, Out + (Selected ? 1 : 0)>::write(v, out);
+    }
+};
+
+template <uint32_t Mask, int Out>
+struct TemporalFeatureWriter<Mask, TEMPORAL_FEATURE_TABLE_SIZE, Out>
+{
+    static void write(const TemporalFeatureValues &, float *) {}
+};
+
+/**
+ * @brief Fusionner dans total les Length échantillons de data (reliquat hors segments)
+ */
+template <unsigned Stats, int Length>
+struct TailMerger
+{
+    static void merge(const float *data, MomentAccumulator &total)
+    {
+        SegmentStats stats;
+        MomentAccumulator part;
+        computeSegmentStatsFor<Stats & ~STAT_MEDIAN, Length>(data, stats);
+        part.assign(stats, data);
+        total.merge(part);
+    }
+};
+
+template <unsigned Stats>
+struct TailMerger<Stats, 1>
+{
+    static void merge(const float *data, MomentAccumulator &total)
+    {
+        total.add(data[0]);
+    }
+};
+
+template <unsigned Stats>
+struct TailMerger<Stats, 0>
+{
+    static void merge(const float *, MomentAccumulator &) {}
+};
+
+/**
+ * @brief Extracteur du sous-ensemble Mask des features temporelles, fenêtre
+ *        découpée selon Geometry (WindowGeometry)
+ *
+ * ExtraStats : statistiques calculées dans la même passe sans être émises
+ * (reprises par l'appelant via window_stats, voir computeWindow()).
+ */
+template <uint32_t Mask, typename Geometry = EEGWindowGeometry, unsigned ExtraStats = 0>
+class TemporalFeatureSet
+{
+public:
+    static_assert(Mask != 0 && (Mask & ~TEMPORAL_FEATURE_MASK_EXTENDED) == 0, "masque hors de TEMPORAL_FEATURE_TABLE");
+
+    static const int NumFeatures = temporalFeatureCount(Mask);
+    static const unsigned Stats = temporalFeatureStats(Mask, ExtraStats);
+
+    /**
+     * @brief Écrire les NumFeatures features à partir de statistiques
+     *        (qui doivent couvrir Stats)
+     */
+    static void write(const SegmentStats &stats, float *out)
+    {
+        TemporalFeatureValues v;
+        deriveTemporalFeatureValues<Stats>(stats, v);
+        TemporalFeatureWriter<Mask, 0, 0>::write(v, out);
+    }
+
+    /**
+     * @brief Calculer uniquement les statistiques nécessaires puis les features
+     */
+    static void compute(const float *data, int length, float *out)
+    {
+        SegmentStats stats;
+        computeSegmentStatsFor<Stats>(data, length, stats);
+        write(stats, out);
+    }
+
+    /**
+     * @brief Features de la fenêtre puis des Geometry::NumSegments segments
+     *        (NumFeatures × (1 + NumSegments) valeurs)
+     *
+     * Chaque segment (et, avec SEGMENT_REMAINDER_DROP, le reliquat) n'est
+     * parcouru qu'une fois ; les statistiques de la fenêtre sont obtenues
+     * par fusion (MomentAccumulator), seule la médiane est recalculée.
+     * @param window_stats Statistiques de la fenêtre (champs de Stats), optionnel
+     */
+    static void computeWindow(const float *window, float *out, SegmentStats *window_stats = nullptr)
+    {
+        MomentAccumulator total;
+        SegmentStats stats;
+        total.reset();
+
+        computeSegments(window, out, total, std::integral_constant<int, 0>());
+        TailMerger<Stats, Geometry::WindowLength - Geometry::Covered>::merge(&window[Geometry::Covered], total);
+
+        total.toSegmentStats(stats);
+        if (Stats & STAT_MEDIAN)
+            stats.median = calculateMedian(window, Geometry::WindowLength);
+        write(stats, out);
+
+        if (window_stats)
+            *window_stats = stats;
+    }
+
+    /**
+     * @brief Position de la feature d'indice feature dans le bloc, −1 si absente
+     */
+    static int indexOf(int feature)
+    {
+        if (!(Mask & (1u << feature)))
+            return -1;
+        return temporalFeatureCount(Mask & ((1u << feature) - 1));
+    }
+
+private:
+    // Segment Seg puis les suivants ; longueur et début constants
+    template <int Seg>
+    static void computeSegments(const float *window, float *out, MomentAccumulator &total,
+                                std::integral_constant<int, Seg>)
+    {
+        const float *segment = &window[Geometry::segmentStart(Seg)];
+        SegmentStats stats;
+        MomentAccumulator part;
+
+        computeSegmentStatsFor<Stats, Geometry::segmentLength(Seg)>(segment, stats);
+        write(stats, &out[(1 + Seg) * NumFeatures]);
+        part.assign(stats, segment);
+        total.merge(part);
+
+        computeSegments(window, out, total, std::integral_constant<int, Seg + 1>());
+    }
+
+    static void computeSegments(const float *, float *, MomentAccumulator &,
+                                std::integral_constant<int, Geometry::NumSegments>)
+    {
+    }
+};
+
+// Masque du préprocesseur (généré avec le scaler)
+#ifndef EEG_TEMPORAL_FEATURE_MASK
+#include "../../include/feature_set.h"
+#endif
+
+// Masques générés avant la version 2 : pas de version écrite
+#ifndef EEG_TEMPORAL_FEATURE_TABLE_VERSION
+#define EEG_TEMPORAL_FEATURE_TABLE_VERSION 1
+#endif
+
+static_assert(EEG_TEMPORAL_FEATURE_TABLE_VERSION <= TEMPORAL_FEATURE_TABLE_VERSION,
+              "feature_set.h généré pour une table de features plus récente");
+
+typedef TemporalFeatureSet<EEG_TEMPORAL_FEATURE_MASK> EEGTemporalFeatureSet;
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file BITalinoEEG_Features.cpp
+ * @brief Implémentation du noyau fusionné de statistiques temporelles
+ *
+ */
+
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_FeatureSet.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+float deviation_scratch[WINDOW_SIZE];
+#endif
+
+void computeSegmentStats(const float *data, int length, SegmentStats &stats)
+{
+    computeSegmentStatsFor<STAT_ALL>(data, length, stats);
+}
+
+void writeTemporalFeatures(const SegmentStats &stats, float *out)
+{
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL>::write(stats, out);
+}
+
+// Tampon de sélection partagé (hors pile de la tâche loop). Le noyau n'est
+// appelé que depuis une seule tâche, il n'est donc pas réentrant.
+static float median_scratch[WINDOW_SIZE];
+
+float calculateMedian(const float *data, int length)
+{
+    memcpy(median_scratch, data, length * sizeof(float));
+
+    int half = length / 2;
+    std::nth_element(median_scratch, median_scratch + half, median_scratch + length);
+    float upper = median_scratch[half];
+
+    if (length % 2 == 0)
+    {
+        float lower = *std::max_element(median_scratch, median_scratch + half);
+        return (lower + upper) / 2.0f;
+    }
+    else
+    {
+        return upper;
+    }
+}
@@ -0,0 +1,317 @@
+/**
+ * @file BITalinoEEG_Features.h
+ * @brief Noyau fusionné de statistiques temporelles pour les features EEG
+ *
+ * Les features temporelles d'un segment (26 historiques, 5 non linéaires
+ * optionnelles) sont dérivées d'une structure SegmentStats remplie en deux
+ * parcours du segment :
+ *  - passe 1 : somme, somme des carrés, min, max, différences absolues,
+ *              passages par zéro, entropie, différences secondes et
+ *              Teager–Kaiser (mêmes différences x[i] − x[i−1]) ;
+ *  - passe 2 : moments centrés (ordre 2, 3, 4) et dispersion des différences.
+ *
+ * Compatibilité avec l'implémentation historique (une boucle par statistique) :
+ * les accumulations sont faites dans le même ordre, donc toutes les features
+ * sont identiques au bit près, sauf l'asymétrie (9) et le kurtosis (10) qui
+ * sont normalisés par std^3 / std^4 après sommation au lieu de l'être pour
+ * chaque échantillon. Écart relatif garanti : <= 1e-5.
+ *
+ * Avec le backend ESP-DSP (BITalinoEEG_DSP.h), la somme, l'énergie et m2 sont
+ * calculés par produits scalaires dsps_dotprod_f32 : l'ordre d'accumulation
+ * change, l'égalité au bit près n'est plus garantie.
+ *
+ * computeSegmentStatsFor<Stats> ne calcule que les statistiques demandées
+ * (drapeaux STAT_*) ; les conditions sont constantes et les branches
+ * inutiles disparaissent à la compilation. Le jeu complet reste identique
+ * au bit près à computeSegmentStats. La variante computeSegmentStatsFor<Stats,
+ * Length> fixe aussi la longueur : toutes les boucles ont un nombre
+ * d'itérations connu du compilateur (déroulage, pipeline logiciel).
+ */
+
+#ifndef BITALINO_EEG_FEATURES_H
+#define BITALINO_EEG_FEATURES_H
+
+#include <cmath>
+#include <type_traits>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_DSP.h"
+#include "BITalinoEEG_FastMath.h"
+
+#define NUM_TEMPORAL_FEATURES 26
+
+// Statistiques suffisantes (dépendances des features, voir BITalinoEEG_FeatureSet.h)
+#define STAT_SUM (1u << 0)
+#define STAT_SUM_SQ (1u << 1)
+#define STAT_MIN_MAX (1u << 2)
+#define STAT_MEDIAN (1u << 3)
+#define STAT_M2 (1u << 4)
+#define STAT_M34 (1u << 5)
+#define STAT_ABS_DIFF (1u << 6)
+#define STAT_ABS_DIFF_DEV (1u << 7)
+#define STAT_ZERO_CROSSINGS (1u << 8)
+#define STAT_ENTROPY (1u << 9)
+#define STAT_DIFF2_SQ (1u << 10)
+#define STAT_TKEO (1u << 11)
+#define STAT_ALL 0xFFFu
+
+/**
+ * @brief Statistiques suffisantes d'un segment pour les features temporelles
+ */
+struct SegmentStats
+{
+    int length;
+
+    float sum;
+    float sum_sq;
+    float min;
+    float max;
+    float median;
+
+    float m2;
+    float m3;
+    float m4;
+
+    float abs_diff_sum;
+    float abs_diff_dev_sq;
+    int zero_crossings;
+    float entropy_sum;
+
+    float diff2_sq_sum; // Σ(x[i+1] − 2x[i] + x[i−1])², i = 1..n−2
+    float tkeo_sum;     // Σ(x[i]² − x[i−1]·x[i+1]), i = 1..n−2
+};
+
+/**
+ * @brief Calculer les statistiques d'un segment en deux parcours
+ * @param data Échantillons filtrés
+ * @param length Nombre d'échantillons (>= 2)
+ * @param stats Structure de sortie
+ */
+void computeSegmentStats(const float *data, int length, SegmentStats &stats);
+
+/**
+ * @brief Écrire les 26 features temporelles à partir des statistiques
+ * @param stats Statistiques du segment
+ * @param out Tableau de sortie (NUM_TEMPORAL_FEATURES éléments)
+ */
+void writeTemporalFeatures(const SegmentStats &stats, float *out);
+
+/**
+ * @brief Médiane d'un segment par sélection (introselect, O(n) en moyenne)
+ *
+ * Résultat identique au tri complet. Le segment est copié dans un tampon
+ * statique de WINDOW_SIZE éléments (non réentrant).
+ */
+float calculateMedian(const float *data, int length);
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+// Écarts à la moyenne (dsps_addc_f32) pour les produits scalaires de la passe 2
+extern float deviation_scratch[WINDOW_SIZE];
+#endif
+
+/**
+ * @brief Noyau de computeSegmentStatsFor : Length vaut int (longueur connue à
+ *        l'exécution) ou std::integral_constant<int, N> (connue à la compilation)
+ */
+template <unsigned Stats, typename Length>
+inline void computeSegmentStatsKernel(const float *data, Length length, SegmentStats &stats)
+{
+    static_assert(!(Stats & (STAT_M2 | STAT_M34)) || (Stats & STAT_SUM), "moments centrés sans STAT_SUM");
+    static_assert(!(Stats & STAT_M34) || (Stats & STAT_M2), "STAT_M34 sans STAT_M2");
+    static_assert(!(Stats & STAT_ABS_DIFF_DEV) || (Stats & STAT_ABS_DIFF), "STAT_ABS_DIFF_DEV sans STAT_ABS_DIFF");
+
+    const bool need_sum = Stats & STAT_SUM;
+    const bool need_sum_sq = Stats & STAT_SUM_SQ;
+    const bool need_min_max = Stats & STAT_MIN_MAX;
+    const bool need_moments = Stats & (STAT_M2 | STAT_M34);
+    const bool need_m34 = Stats & STAT_M34;
+    const bool need_abs_diff = Stats & STAT_ABS_DIFF;
+    const bool need_abs_diff_dev = Stats & STAT_ABS_DIFF_DEV;
+    const bool need_zero_crossings = Stats & STAT_ZERO_CROSSINGS;
+    const bool need_entropy = Stats & STAT_ENTROPY;
+    const bool need_diff2_sq = Stats & STAT_DIFF2_SQ;
+    const bool need_tkeo = Stats & STAT_TKEO;
+
+#ifdef EEG_DSP_BACKEND_ESPDSP
+    float sum = need_sum ? dspSum(data, length) : 0;
+    float sum_sq = need_sum_sq ? dspDotProduct(data, data, length) : 0;
+#else
+    float sum = 0;
+    float sum_sq = 0;
+#endif
+    float min_val = data[0];
+    float max_val = data[0];
+    float abs_diff_sum = 0;
+    float entropy_sum = 0;
+    float diff2_sq_sum = 0;
+    float tkeo_sum = 0;
+    float prev_diff = 0;
+    int zero_crossings = 0;
+
+#ifndef EEG_DSP_BACKEND_ESPDSP
+    if (need_sum)
+        sum += data[0];
+    if (need_sum_sq)
+        sum_sq += data[0] * data[0];
+#endif
+    if (need_entropy)
+    {
+        float p0 = std::abs(data[0]) + 1e-8;
+        entropy_sum += p0 * eegLog(p0);
+    }
+
+    for (int i = 1; i < length; i++)
+    {
+        float x = data[i];
+        float prev = data[i - 1];
+
+#ifndef EEG_DSP_BACKEND_ESPDSP
+        if (need_sum)
+            sum += x;
+        if (need_sum_sq)
+            sum_sq += x * x;
+#endif
+
+        if (need_min_max)
+        {
+            if (x < min_val)
+                min_val = x;
+            if (x > max_val)
+                max_val = x;
+        }
+
+        float diff = x - prev;
+        if (need_abs_diff)
+            abs_diff_sum += std::abs(diff);
+
+        // Centrés sur prev : premier terme à i = 2
+        if (i >= 2)
+        {
+            if (need_diff2_sq)
+            {
+                float diff2 = diff - prev_diff;
+                diff2_sq_sum += diff2 * diff2;
+            }
+            if (need_tkeo)
+                tkeo_sum += prev * prev - data[i - 2] * x;
+        }
+        prev_diff = diff;
+
+        if (need_zero_crossings && (prev < 0) != (x < 0))
+            zero_crossings++;
+
+        if (need_entropy)
+        {
+            float p = std::abs(x) + 1e-8;
+            entropy_sum += p * eegLog(p);
+        }
+    }
+
+    float mean = sum / length;
+    float mean_diff = abs_diff_sum / (length - 1);
+
+    float m2 = 0;
+    float m3 = 0;
+    float m4 = 0;
+    float abs_diff_dev_sq = 0;
+
+    if (need_moments || need_abs_diff_dev)
+    {
+#ifdef EEG_DSP_BACKEND_ESPDSP
+        if (need_moments)
+        {
+            dspAddConstant(data, deviation_scratch, length, -mean);
+            m2 = dspDotProduct(deviation_scratch, deviation_scratch, length);
+        }
+
+        for (int i = 0; i < length; i++)
+        {
+            if (need_m34)
+            {
+                float d = deviation_scratch[i];
+                float d_sq = d * d;
+                m3 += d_sq * d;
+                m4 += d_sq * d_sq;
+            }
+
+            if (need_abs_diff_dev && i > 0)
+            {
+                float dev = std::abs(data[i] - data[i - 1]) - mean_diff;
+                abs_diff_dev_sq += dev * dev;
+            }
+        }
+#else
+        if (need_moments)
+        {
+            float d0 = data[0] - mean;
+            m2 += d0 * d0;
+            if (need_m34)
+            {
+                m3 += d0 * d0 * d0;
+                m4 += d0 * d0 * d0 * d0;
+            }
+        }
+
+        for (int i = 1; i < length; i++)
+        {
+            if (need_moments)
+            {
+                float d = data[i] - mean;
+                float d_sq = d * d;
+                m2 += d_sq;
+                if (need_m34)
+                {
+                    m3 += d_sq * d;
+                    m4 += d_sq * d_sq;
+                }
+            }
+
+            if (need_abs_diff_dev)
+            {
+                float dev = std::abs(data[i] - data[i - 1]) - mean_diff;
+                abs_diff_dev_sq += dev * dev;
+            }
+        }
+#endif
+    }
+
+    stats.length = length;
+    stats.sum = sum;
+    stats.sum_sq = sum_sq;
+    stats.min = min_val;
+    stats.max = max_val;
+    stats.median = (Stats & STAT_MEDIAN) ? calculateMedian(data, length) : 0;
+    stats.m2 = m2;
+    stats.m3 = m3;
+    stats.m4 = m4;
+    stats.abs_diff_sum = abs_diff_sum;
+    stats.abs_diff_dev_sq = abs_diff_dev_sq;
+    stats.zero_crossings = zero_crossings;
+    stats.entropy_sum = entropy_sum;
+    stats.diff2_sq_sum = diff2_sq_sum;
+    stats.tkeo_sum = tkeo_sum;
+}
+
+/**
+ * @brief computeSegmentStats restreint aux statistiques Stats (drapeaux STAT_*)
+ *
+ * Les champs non demandés valent 0 (min/max : premier échantillon). Les
+ * dépendances doivent être closes : STAT_M2/STAT_M34 supposent STAT_SUM,
+ * STAT_M34 suppose STAT_M2, STAT_ABS_DIFF_DEV suppose STAT_ABS_DIFF.
+ */
+template <unsigned Stats>
+inline void computeSegmentStatsFor(const float *data, int length, SegmentStats &stats)
+{
+    computeSegmentStatsKernel<Stats>(data, length, stats);
+}
+
+/**
+ * @brief computeSegmentStatsFor pour une longueur Length fixée à la compilation
+ */
+template <unsigned Stats, int Length>
+inline void computeSegmentStatsFor(const float *data, SegmentStats &stats)
+{
+    static_assert(Length >= 2, "segment d'au moins 2 échantillons");
+    computeSegmentStatsKernel<Stats>(data, std::integral_constant<int, Length>(), stats);
+}
+
+#endif
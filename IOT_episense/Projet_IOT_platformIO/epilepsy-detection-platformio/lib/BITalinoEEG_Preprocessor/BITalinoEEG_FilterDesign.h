@@ -0,0 +1,159 @@
+/**
+ * @file BITalinoEEG_FilterDesign.h
+ * @brief Calcul des sections biquad (Butterworth, réjecteur secteur) par
+ *        transformée bilinéaire, évaluable à la compilation
+ *
+ * Chaque section est le prototype analogique du second ordre transposé par
+ * transformée bilinéaire avec pré-distorsion à la fréquence caractéristique
+ * (formules de R. Bristow-Johnson) :
+ *   w0 = 2π·f/fs, α = sin(w0) / (2Q)
+ *   passe-bas  : b = (1 − cos w0)/2 · {1, 2, 1}
+ *   passe-haut : b = (1 + cos w0)/2 · {1, −2, 1}
+ *   réjecteur  : b = {1, −2·cos w0, 1}
+ *   a = {1 + α, −2·cos w0, 1 − α}, puis normalisation par a0
+ * Un Butterworth d'ordre N est la cascade de N/2 sections de facteurs
+ * Q_k = 1 / (2·sin((2k + 1)·π / (2N))).
+ *
+ * Toutes les fonctions sont constexpr (sinus et cosinus compris) : à
+ * fréquence fixe, le passe-bande est calculé par le compilateur et rangé en
+ * mémoire morte (BANDPASS_SECTIONS), sans aucun coût à l'exécution. Les mêmes
+ * fonctions servent au démarrage quand la fréquence secteur est choisie à
+ * l'exécution (BITalinoEEGPreprocessor::begin).
+ */
+
+#ifndef BITALINO_EEG_FILTER_DESIGN_H
+#define BITALINO_EEG_FILTER_DESIGN_H
+
+#include <cmath>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_Filters.h"
+
+/**
+ * @brief Jeu de N sections (type littéral, renvoyable par une fonction constexpr)
+ */
+template <int N>
+struct BiquadSectionSet
+{
+    BiquadCoefficients section[N];
+};
+
+/**
+ * @brief Sinus en double précision évaluable à la compilation
+ */
+constexpr double designSin(double x)
+{
+    while (x > M_PI)
+        x -= 2 * M_PI;
+    while (x < -M_PI)
+        x += 2 * M_PI;
+
+    // Série de Taylor, |x| ≤ π : terme 2·20 + 1 < 1e-20
+    double term = x;
+    double sum = x;
+    for (int n = 1; n <= 20; n++)
+    {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double designCos(double x)
+{
+    return designSin(x + M_PI / 2);
+}
+
+/**
+ * @brief Facteur de qualité de la k-ième section d'un Butterworth d'ordre order (pair)
+ */
+constexpr double butterworthQ(int order, int k)
+{
+    return 1.0 / (2.0 * designSin((2 * k + 1) * M_PI / (2.0 * order)));
+}
+
+/**
+ * @brief Normaliser {b0, b1, b2, a0, a1, a2} en section a0 = 1
+ */
+constexpr BiquadCoefficients normalizedBiquad(double b0, double b1, double b2,
+                                              double a0, double a1, double a2)
+{
+    return BiquadCoefficients{(float)(b0 / a0), (float)(b1 / a0), (float)(b2 / a0),
+                              (float)(a1 / a0), (float)(a2 / a0)};
+}
+
+/**
+ * @brief Section passe-bas du second ordre (coupure fc, facteur q)
+ */
+constexpr BiquadCoefficients designLowpass(double fc, double fs, double q)
+{
+    const double w0 = 2 * M_PI * fc / fs;
+    const double c = designCos(w0);
+    const double alpha = designSin(w0) / (2 * q);
+    return normalizedBiquad((1 - c) / 2, 1 - c, (1 - c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+/**
+ * @brief Section passe-haut du second ordre (coupure fc, facteur q)
+ */
+constexpr BiquadCoefficients designHighpass(double fc, double fs, double q)
+{
+    const double w0 = 2 * M_PI * fc / fs;
+    const double c = designCos(w0);
+    const double alpha = designSin(w0) / (2 * q);
+    return normalizedBiquad((1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+/**
+ * @brief Réjecteur centré sur f0 (largeur à −3 dB ≈ f0 / q)
+ */
+constexpr BiquadCoefficients designNotch(double f0, double fs, double q)
+{
+    const double w0 = 2 * M_PI * f0 / fs;
+    const double c = designCos(w0);
+    const double alpha = designSin(w0) / (2 * q);
+    return normalizedBiquad(1, -2 * c, 1, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+/**
+ * @brief Section identité (réjecteur désactivé)
+ */
+constexpr BiquadCoefficients identityBiquad()
+{
+    return BiquadCoefficients{1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+/**
+ * @brief Multiplier le numérateur d'une section par gain
+ */
+constexpr BiquadCoefficients scaledBiquad(const BiquadCoefficients &c, double gain)
+{
+    return BiquadCoefficients{(float)(c.b0 * gain), (float)(c.b1 * gain), (float)(c.b2 * gain), c.a1, c.a2};
+}
+
+/**
+ * @brief Passe-bande EEG complet à fs : passe-haut Butterworth d'ordre
+ *        EEG_HIGHPASS_ORDER, passe-bas Butterworth d'ordre EEG_LOWPASS_ORDER
+ *        (gain EEG_BANDPASS_GAIN), réjecteur à mains_frequency (0 : aucun)
+ */
+constexpr BiquadSectionSet<BANDPASS_NUM_SECTIONS> designEEGBandpass(double fs, int mains_frequency)
+{
+    BiquadSectionSet<BANDPASS_NUM_SECTIONS> set = {};
+    int s = 0;
+
+    for (int k = 0; k < EEG_HIGHPASS_ORDER / 2; k++)
+        set.section[s++] = designHighpass(EEG_HIGHPASS_HZ, fs, butterworthQ(EEG_HIGHPASS_ORDER, k));
+
+    for (int k = 0; k < EEG_LOWPASS_ORDER / 2; k++)
+    {
+        BiquadCoefficients lowpass = designLowpass(EEG_LOWPASS_HZ, fs, butterworthQ(EEG_LOWPASS_ORDER, k));
+        set.section[s++] = k == 0 ? scaledBiquad(lowpass, EEG_BANDPASS_GAIN) : lowpass;
+    }
+
+    // Réjecteur hors de la bande représentable : désactivé
+    set.section[s] = mains_frequency > 0 && 2 * mains_frequency < fs
+                         ? designNotch(mains_frequency, fs, EEG_NOTCH_Q)
+                         : identityBiquad();
+    return set;
+}
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file BITalinoEEG_Filters.cpp
+ * @brief Coefficients du passe-bande EEG en sections biquad
+ *
+ */
+
+#include "BITalinoEEG_Filters.h"
+#include "BITalinoEEG_FilterDesign.h"
+
+/*
+ * Passe-haut : Butterworth d'ordre 4, fc = 0.5 Hz (mêmes coefficients que
+ * l'ancienne table). Passe-bas : Butterworth d'ordre 4 à 22.4 Hz, gain
+ * EEG_BANDPASS_GAIN, en remplacement de l'ancien LPF_* codé en dur pour
+ * 178 Hz. Réjecteur secteur en dernière section.
+ *
+ * constexpr : table évaluée par le compilateur, placée en mémoire morte.
+ */
+static constexpr BiquadSectionSet<BANDPASS_NUM_SECTIONS> BANDPASS_DESIGN =
+    designEEGBandpass(SAMPLE_RATE, EEG_MAINS_FREQUENCY);
+
+static_assert(BANDPASS_DESIGN.section[0].a2 < 1.0f && BANDPASS_DESIGN.section[BANDPASS_NUM_SECTIONS - 1].a2 < 1.0f,
+              "passe-bande instable");
+
+const BiquadCoefficients (&BANDPASS_SECTIONS)[BANDPASS_NUM_SECTIONS] = BANDPASS_DESIGN.section;
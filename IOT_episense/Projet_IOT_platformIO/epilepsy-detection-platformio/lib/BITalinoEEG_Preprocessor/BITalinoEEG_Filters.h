@@ -0,0 +1,187 @@
+/**
+ * @file BITalinoEEG_Filters.h
+ * @brief Filtrage IIR en cascade de sections du second ordre (biquads)
+ *
+ * Chaque section est en forme directe II transposée :
+ *   y    = b0·x + z1
+ *   z1'  = b1·x − a1·y + z2
+ *   z2'  = b2·x − a2·y
+ * Deux variables d'état par section, aucun décalage de tableau. Le passe-bande
+ * complet (passe-haut, passe-bas puis réjecteur secteur) est exécuté comme
+ * une seule cascade.
+ */
+
+#ifndef BITALINO_EEG_FILTERS_H
+#define BITALINO_EEG_FILTERS_H
+
+#include "BITalinoEEG_Config.h"
+
+/**
+ * @brief Coefficients d'une section biquad normalisée (a0 = 1)
+ */
+struct BiquadCoefficients
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+};
+
+// Passe-haut, passe-bas, réjecteur (section identité s'il est désactivé)
+#define BANDPASS_NUM_SECTIONS (EEG_HIGHPASS_ORDER / 2 + EEG_LOWPASS_ORDER / 2 + 1)
+
+/**
+ * @brief Sections du passe-bande EEG à SAMPLE_RATE, réjecteur à
+ *        EEG_MAINS_FREQUENCY (calculées à la compilation)
+ */
+extern const BiquadCoefficients (&BANDPASS_SECTIONS)[BANDPASS_NUM_SECTIONS];
+
+/**
+ * @brief Cascade de NumSections biquads en forme directe II transposée
+ */
+template <int NumSections>
+class BiquadCascade
+{
+public:
+    explicit BiquadCascade(const BiquadCoefficients *sections = BANDPASS_SECTIONS)
+        : sections(sections)
+    {
+        reset();
+    }
+
+    void setSections(const BiquadCoefficients *new_sections)
+    {
+        sections = new_sections;
+        reset();
+    }
+
+    void reset()
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            z1[s] = 0;
+            z2[s] = 0;
+        }
+    }
+
+    /**
+     * @brief Filtrer un échantillon à travers toute la cascade
+     */
+    float process(float x)
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            const BiquadCoefficients &c = sections[s];
+            float y = c.b0 * x + z1[s];
+            z1[s] = c.b1 * x - c.a1 * y + z2[s];
+            z2[s] = c.b2 * x - c.a2 * y;
+            x = y;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Filtrer un bloc de n échantillons (in et out peuvent être égaux)
+     *
+     * Le bloc traverse une section à la fois : coefficients et état restent
+     * dans des registres pendant toute la boucle interne.
+     */
+    void processBlock(const float *in, float *out, int n)
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            const float b0 = sections[s].b0;
+            const float b1 = sections[s].b1;
+            const float b2 = sections[s].b2;
+            const float a1 = sections[s].a1;
+            const float a2 = sections[s].a2;
+            float s1 = z1[s];
+            float s2 = z2[s];
+
+            for (int i = 0; i < n; i++)
+            {
+                float x = in[i];
+                float y = b0 * x + s1;
+                s1 = b1 * x - a1 * y + s2;
+                s2 = b2 * x - a2 * y;
+                out[i] = y;
+            }
+
+            z1[s] = s1;
+            z2[s] = s2;
+            in = out;
+        }
+    }
+
+private:
+    const BiquadCoefficients *sections;
+    float z1[NumSections];
+    float z2[NumSections];
+};
+
+/**
+ * @brief Même cascade appliquée à Channels voies échantillonnées ensemble
+ *
+ * L'état est rangé par section puis par voie : la boucle interne parcourt
+ * les voies avec des coefficients communs (vectorisable). Chaque voie donne
+ * exactement la sortie d'un BiquadCascade<NumSections>.
+ */
+template <int NumSections, int Channels>
+class MultiChannelBiquadCascade
+{
+public:
+    explicit MultiChannelBiquadCascade(const BiquadCoefficients *sections = BANDPASS_SECTIONS)
+        : sections(sections)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            for (int c = 0; c < Channels; c++)
+            {
+                z1[s][c] = 0;
+                z2[s][c] = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Filtrer une trame (un échantillon par voie ; in et out peuvent être égaux)
+     */
+    void processFrame(const float *in, float *out)
+    {
+        for (int c = 0; c < Channels; c++)
+        {
+            out[c] = in[c];
+        }
+
+        for (int s = 0; s < NumSections; s++)
+        {
+            const float b0 = sections[s].b0;
+            const float b1 = sections[s].b1;
+            const float b2 = sections[s].b2;
+            const float a1 = sections[s].a1;
+            const float a2 = sections[s].a2;
+
+            for (int c = 0; c < Channels; c++)
+            {
+                float x = out[c];
+                float y = b0 * x + z1[s][c];
+                z1[s][c] = b1 * x - a1 * y + z2[s][c];
+                z2[s][c] = b2 * x - a2 * y;
+                out[c] = y;
+            }
+        }
+    }
+
+private:
+    const BiquadCoefficients *sections;
+    float z1[NumSections][Channels];
+    float z2[NumSections][Channels];
+};
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file BITalinoEEG_Fixed.cpp
+ * @brief Implémentation des noyaux DSP en virgule fixe
+ *
+ */
+
+#include "BITalinoEEG_Fixed.h"
+#include "BITalinoEEG_Config.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+void quantizeBiquad(const BiquadCoefficients &in, BiquadCoefficientsQ30 &out)
+{
+    const double scale = (double)(1 << BIQUAD_Q_BITS);
+    out.b0 = (int32_t)std::lround(in.b0 * scale);
+    out.b1 = (int32_t)std::lround(in.b1 * scale);
+    out.b2 = (int32_t)std::lround(in.b2 * scale);
+    out.a1 = (int32_t)std::lround(in.a1 * scale);
+    out.a2 = (int32_t)std::lround(in.a2 * scale);
+}
+
+// log2(1 + i/64) en Q16, i = 0..64
+static const int32_t LOG2_TABLE[65] = {
+    0, 1466, 2909, 4331, 5732, 7112, 8473, 9814,
+    11136, 12440, 13727, 14996, 16248, 17484, 18704, 19909,
+    21098, 22272, 23433, 24579, 25711, 26830, 27936, 29029,
+    30109, 31178, 32234, 33279, 34312, 35334, 36346, 37346,
+    38336, 39316, 40286, 41246, 42196, 43137, 44068, 44990,
+    45904, 46809, 47705, 48593, 49472, 50344, 51207, 52063,
+    52911, 53751, 54584, 55410, 56229, 57040, 57845, 58643,
+    59434, 60219, 60997, 61769, 62534, 63294, 64047, 64794,
+    65536,
+};
+
+int32_t fixedLog2(uint32_t v)
+{
+    int exponent = 31 - __builtin_clz(v);
+
+    // Mantisse normalisée sur 32 bits : 1.xxxx avec le bit de tête en 31
+    uint32_t mantissa = v << (31 - exponent);
+    uint32_t index = (mantissa >> 25) & 63;
+    uint32_t frac = (mantissa >> 9) & 0xFFFF;
+
+    int32_t lo = LOG2_TABLE[index];
+    int32_t hi = LOG2_TABLE[index + 1];
+    int32_t interp = lo + (int32_t)(((int64_t)(hi - lo) * frac) >> 16);
+
+    return (exponent << 16) + interp;
+}
+
+// Tampon de sélection pour la médiane (non réentrant, comme calculateMedian)
+static eeg_fixed_t median_scratch[WINDOW_SIZE];
+
+static int64_t medianTimesTwo(const eeg_fixed_t *data, int length)
+{
+    memcpy(median_scratch, data, length * sizeof(eeg_fixed_t));
+
+    int half = length / 2;
+    std::nth_element(median_scratch, median_scratch + half, median_scratch + length);
+    int64_t upper = median_scratch[half];
+
+    if (length % 2 == 0)
+    {
+        int64_t lower = *std::max_element(median_scratch, median_scratch + half);
+        return lower + upper;
+    }
+    return 2 * upper;
+}
+
+static int bitLength(uint32_t v)
+{
+    return v == 0 ? 0 : 32 - __builtin_clz(v);
+}
+
+void computeFixedSegmentStats(const eeg_fixed_t *data, int length, FixedSegmentStats &stats)
+{
+    int64_t sum = data[0];
+    int64_t sum_sq = (int64_t)data[0] * data[0];
+    int64_t abs_diff_sum = 0;
+    int64_t sq_diff_sum = 0;
+    int64_t entropy_sum = 0;
+    int64_t diff2_sq_sum = 0;
+    int64_t tkeo_sum = 0;
+    eeg_fixed_t min_val = data[0];
+    eeg_fixed_t max_val = data[0];
+    int zero_crossings = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        eeg_fixed_t x = data[i];
+
+        if (i > 0)
+        {
+            eeg_fixed_t prev = data[i - 1];
+            sum += x;
+            sum_sq += (int64_t)x * x;
+
+            if (x < min_val)
+                min_val = x;
+            if (x > max_val)
+                max_val = x;
+
+            int64_t diff = x > prev ? (int64_t)x - prev : (int64_t)prev - x;
+            abs_diff_sum += diff;
+            sq_diff_sum += diff * diff;
+
+            if ((prev < 0) != (x < 0))
+                zero_crossings++;
+        }
+
+        if (i > 1)
+        {
+            int64_t prev = data[i - 1];
+            int64_t prev2 = data[i - 2];
+            int64_t diff2 = x - 2 * prev + prev2;
+            diff2_sq_sum += diff2 * diff2;
+            tkeo_sum += prev * prev - prev2 * x;
+        }
+
+        // |x|·ln|x| en µV : v·(log2(v) − 8)·ln2 / 2^24, le facteur est appliqué
+        // à la conversion. x = 0 contribue 0 (1e-8·ln(1e-8) en float).
+        uint32_t v = x < 0 ? -x : x;
+        if (v != 0)
+        {
+            entropy_sum += (int64_t)v * (fixedLog2(v) - (EEG_FIXED_FRAC_BITS << 16));
+        }
+    }
+
+    // Moyenne arrondie au Q8 le plus proche ; l'écart (< 1/512 µV) est négligé
+    // dans les moments d'ordre 3 et 4.
+    int64_t mean = sum >= 0 ? (sum + length / 2) / length : -((-sum + length / 2) / length);
+
+    // Décalage par segment : |d| < 2^13 après décalage, d⁴·n reste < 2^61
+    int64_t span = std::max((int64_t)max_val - mean, mean - (int64_t)min_val);
+    int shift = std::max(0, bitLength((uint32_t)span) - 13);
+    int64_t round = shift > 0 ? (int64_t)1 << (shift - 1) : 0;
+
+    int64_t m3 = 0;
+    int64_t m4 = 0;
+    for (int i = 0; i < length; i++)
+    {
+        int64_t d = (data[i] - mean + round) >> shift;
+        int64_t d_sq = d * d;
+        m3 += d_sq * d;
+        m4 += d_sq * d_sq;
+    }
+
+    stats.length = length;
+    stats.sum = sum;
+    stats.sum_sq = sum_sq;
+    stats.min = min_val;
+    stats.max = max_val;
+    stats.median_x2 = medianTimesTwo(data, length);
+    stats.m2_scaled = length * sum_sq - sum * sum;
+    stats.m3 = m3;
+    stats.m4 = m4;
+    stats.moment_shift = shift;
+    stats.abs_diff_sum = abs_diff_sum;
+    stats.abs_diff_dev_scaled = (length - 1) * sq_diff_sum - abs_diff_sum * abs_diff_sum;
+    stats.zero_crossings = zero_crossings;
+    stats.entropy_sum = entropy_sum;
+    stats.diff2_sq_sum = diff2_sq_sum;
+    stats.tkeo_sum = tkeo_sum;
+}
+
+void fixedToSegmentStats(const FixedSegmentStats &fixed, SegmentStats &stats)
+{
+    const float q8 = 1.0f / EEG_FIXED_ONE;
+    const float q16 = q8 * q8;
+    int n = fixed.length;
+
+    stats.length = n;
+    stats.sum = fixed.sum * q8;
+    stats.sum_sq = fixed.sum_sq * q16;
+    stats.min = fixed.min * q8;
+    stats.max = fixed.max * q8;
+    stats.median = fixed.median_x2 * (q8 * 0.5f);
+    stats.m2 = (float)fixed.m2_scaled / n * q16;
+    stats.m3 = std::ldexp((float)fixed.m3, 3 * (fixed.moment_shift - EEG_FIXED_FRAC_BITS));
+    stats.m4 = std::ldexp((float)fixed.m4, 4 * (fixed.moment_shift - EEG_FIXED_FRAC_BITS));
+    stats.abs_diff_sum = fixed.abs_diff_sum * q8;
+    stats.abs_diff_dev_sq = (float)fixed.abs_diff_dev_scaled / (n - 1) * q16;
+    stats.zero_crossings = fixed.zero_crossings;
+    stats.entropy_sum = std::ldexp((float)fixed.entropy_sum * (float)M_LN2, -24);
+    stats.diff2_sq_sum = fixed.diff2_sq_sum * q16;
+    stats.tkeo_sum = fixed.tkeo_sum * q16;
+}
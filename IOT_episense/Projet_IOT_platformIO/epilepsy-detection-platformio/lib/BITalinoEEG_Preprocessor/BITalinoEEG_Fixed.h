@@ -0,0 +1,225 @@
+/**
+ * @file BITalinoEEG_Fixed.h
+ * @brief Chaîne DSP en virgule fixe (filtrage + statistiques entières)
+ *
+ * Activée à la compilation par -DBITALINO_FIXED_POINT (voir env:esp32dev_fixed).
+ * Les noyaux sont toujours compilés pour pouvoir être testés sur l'hôte.
+ *
+ * Formats :
+ *  - Échantillons : int32 en µV Q8 (1/256 µV). La conversion ADC est exacte :
+ *    (adc − 512) × 3.3 / 1024 / 1000 × 1e6 × 256 = (adc − 512) × 825.
+ *    Plage utile ±4096 µV (|x| < 2^20).
+ *  - Coefficients biquad : Q30 (|c| < 2), accumulation sur 64 bits. Dans la
+ *    cascade, le signal porte 6 bits de garde (Q14, |x| < 2^26, 5 bits de
+ *    marge pour les surtensions des sections) : le bruit
+ *    d'arrondi, amplifié par les pôles du passe-haut, reste < 0.01 µV.
+ *  - Statistiques : sommes entières sur 64 bits, moments d'ordre 3 et 4 avec
+ *    un décalage choisi par segment (virgule fixe par bloc).
+ *
+ * La conversion en float n'a lieu qu'à la frontière des features
+ * (fixedToSegmentStats), avant writeTemporalFeatures et la normalisation.
+ */
+
+#ifndef BITALINO_EEG_FIXED_H
+#define BITALINO_EEG_FIXED_H
+
+#include <stdint.h>
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_Filters.h"
+
+typedef int32_t eeg_fixed_t;
+
+#define EEG_FIXED_FRAC_BITS 8
+#define EEG_FIXED_ONE (1 << EEG_FIXED_FRAC_BITS)
+#define EEG_FIXED_MAX ((1 << 20) - 1)
+#define EEG_ADC_MIDSCALE 512
+#define EEG_ADC_TO_FIXED 825
+#define BIQUAD_Q_BITS 30
+#define BIQUAD_GUARD_BITS 6
+
+/**
+ * @brief Convertir une valeur ADC en µV Q8 (exact)
+ */
+inline eeg_fixed_t adcToFixed(int adc_value)
+{
+    return (adc_value - EEG_ADC_MIDSCALE) * EEG_ADC_TO_FIXED;
+}
+
+inline float fixedToMicrovolts(eeg_fixed_t value)
+{
+    return value * (1.0f / EEG_FIXED_ONE);
+}
+
+/**
+ * @brief Coefficients d'une section biquad en Q30
+ */
+struct BiquadCoefficientsQ30
+{
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+};
+
+/**
+ * @brief Quantifier des coefficients float en Q30 (arrondi au plus proche)
+ */
+void quantizeBiquad(const BiquadCoefficients &in, BiquadCoefficientsQ30 &out);
+
+/**
+ * @brief Cascade de biquads entiers en forme directe I
+ *
+ * La forme directe I garde des états à la résolution du signal (pas de
+ * variables internes à grande dynamique comme en DF-II transposée). Le reste
+ * de chaque arrondi est réinjecté à l'échantillon suivant (« fraction saving ») :
+ * le bruit de quantification est rejeté hors de la bande des pôles proches de
+ * z = 1 du passe-haut à 0.5 Hz.
+ */
+template <int NumSections>
+class FixedBiquadCascade
+{
+public:
+    explicit FixedBiquadCascade(const BiquadCoefficients *sections = BANDPASS_SECTIONS)
+    {
+        setSections(sections);
+    }
+
+    void setSections(const BiquadCoefficients *sections)
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            quantizeBiquad(sections[s], coefficients[s]);
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        for (int s = 0; s < NumSections; s++)
+        {
+            x1[s] = 0;
+            x2[s] = 0;
+            y1[s] = 0;
+            y2[s] = 0;
+            error[s] = 0;
+        }
+    }
+
+    eeg_fixed_t process(eeg_fixed_t x)
+    {
+        x *= 1 << BIQUAD_GUARD_BITS;
+        for (int s = 0; s < NumSections; s++)
+        {
+            x = step(s, x);
+        }
+        return output(x);
+    }
+
+    /**
+     * @brief Filtrer un bloc de n échantillons (in et out peuvent être égaux)
+     */
+    void processBlock(const eeg_fixed_t *in, eeg_fixed_t *out, int n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            out[i] = in[i] * (1 << BIQUAD_GUARD_BITS);
+        }
+        for (int s = 0; s < NumSections; s++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                out[i] = step(s, out[i]);
+            }
+        }
+        for (int i = 0; i < n; i++)
+        {
+            out[i] = output(out[i]);
+        }
+    }
+
+private:
+    BiquadCoefficientsQ30 coefficients[NumSections];
+    int32_t x1[NumSections];
+    int32_t x2[NumSections];
+    int32_t y1[NumSections];
+    int32_t y2[NumSections];
+    int64_t error[NumSections];
+
+    int32_t step(int s, int32_t x)
+    {
+        const BiquadCoefficientsQ30 &c = coefficients[s];
+        int64_t acc = error[s];
+        acc += (int64_t)c.b0 * x;
+        acc += (int64_t)c.b1 * x1[s];
+        acc += (int64_t)c.b2 * x2[s];
+        acc -= (int64_t)c.a1 * y1[s];
+        acc -= (int64_t)c.a2 * y2[s];
+
+        int32_t y = (int32_t)(acc >> BIQUAD_Q_BITS);
+        error[s] = acc - ((int64_t)y << BIQUAD_Q_BITS);
+
+        x2[s] = x1[s];
+        x1[s] = x;
+        y2[s] = y1[s];
+        y1[s] = y;
+        return y;
+    }
+
+    // Retrait des bits de garde (arrondi) et saturation à la plage utile
+    static eeg_fixed_t output(int32_t x)
+    {
+        x = (x + (1 << (BIQUAD_GUARD_BITS - 1))) >> BIQUAD_GUARD_BITS;
+        if (x > EEG_FIXED_MAX)
+            return EEG_FIXED_MAX;
+        if (x < -EEG_FIXED_MAX)
+            return -EEG_FIXED_MAX;
+        return x;
+    }
+};
+
+/**
+ * @brief Statistiques entières d'un segment (unités Q8 / Q16 du signal)
+ */
+struct FixedSegmentStats
+{
+    int length;
+
+    int64_t sum;          // Q8
+    int64_t sum_sq;       // Q16
+    eeg_fixed_t min;
+    eeg_fixed_t max;
+    int64_t median_x2;    // Q8, deux fois la médiane (longueurs paires)
+
+    int64_t m2_scaled;    // n·Σx² − (Σx)², Q16
+    int64_t m3;           // Σd³ avec d = (x − moyenne) >> moment_shift
+    int64_t m4;           // Σd⁴ avec d = (x − moyenne) >> moment_shift
+    int moment_shift;
+
+    int64_t abs_diff_sum;        // Q8
+    int64_t abs_diff_dev_scaled; // (n−1)·Σdiff² − (Σ|diff|)², Q16
+    int zero_crossings;
+    int64_t entropy_sum;         // Σ v·(log2(v) − 8), v en Q8, log2 en Q16
+    int64_t diff2_sq_sum;        // Σ(x[i+1] − 2x[i] + x[i−1])², Q16
+    int64_t tkeo_sum;            // Σ(x[i]² − x[i−1]·x[i+1]), Q16
+};
+
+/**
+ * @brief log2(v) en Q16 (table de 64 entrées + interpolation, erreur < 2e-4)
+ * @param v Valeur strictement positive
+ */
+int32_t fixedLog2(uint32_t v);
+
+/**
+ * @brief Calculer les statistiques entières d'un segment (deux parcours)
+ * @param data Échantillons filtrés en µV Q8
+ * @param length Nombre d'échantillons (2 à WINDOW_SIZE)
+ */
+void computeFixedSegmentStats(const eeg_fixed_t *data, int length, FixedSegmentStats &stats);
+
+/**
+ * @brief Convertir les statistiques entières en SegmentStats (µV, float)
+ */
+void fixedToSegmentStats(const FixedSegmentStats &fixed, SegmentStats &stats);
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file BITalinoEEG_Frame.h
+ * @brief Décodage des trames BITalino en mode live (CRC, séquence, resynchronisation)
+ *
+ * Une trame fait ceil((12 + 10·n) / 8) octets pour n ≤ 4 voies analogiques,
+ * ceil((52 + 6·(n − 4)) / 8) au-delà, et se lit depuis la fin :
+ *  - dernier octet : numéro de séquence (bits 7..4), CRC-4 (bits 3..0) ;
+ *  - avant-dernier : entrées numériques I1..I4 (bits 7..4), puis A1 sur
+ *    10 bits à cheval sur l'octet précédent, A2, A3, A4 (10 bits), A5 et
+ *    A6 (6 bits).
+ * Le CRC (x⁴ + x + 1) porte sur toute la trame, ses propres bits à zéro.
+ *
+ * Le protocole n'a pas d'octet de synchronisation : le décodeur accumule
+ * FrameBytes octets et, si le CRC échoue, glisse d'un octet. Une trame
+ * rejetée ou perdue apparaît comme un saut du numéro de séquence sur la
+ * trame valide suivante (sauts modulo 16).
+ */
+
+#ifndef BITALINO_EEG_FRAME_H
+#define BITALINO_EEG_FRAME_H
+
+#include <stdint.h>
+#include <string.h>
+#include "BITalinoEEG_Config.h"
+
+struct BITalinoFrame
+{
+    uint8_t seq;
+    uint8_t digital[4];
+    uint16_t analog[BITALINO_NUM_ANALOG_CHANNELS];
+};
+
+/**
+ * @brief Taille d'une trame pour channels voies analogiques (1-6)
+ */
+constexpr int bitalinoFrameBytes(int channels)
+{
+    return channels <= 4 ? (12 + 10 * channels + 7) / 8 : (52 + 6 * (channels - 4) + 7) / 8;
+}
+
+/**
+ * @brief CRC-4 d'une trame (champ CRC du dernier octet ignoré)
+ */
+inline uint8_t bitalinoFrameCRC(const uint8_t *frame, int length)
+{
+    uint8_t crc = 0;
+    for (int i = 0; i < length; i++)
+    {
+        uint8_t byte = i == length - 1 ? frame[i] & 0xF0 : frame[i];
+        for (int bit = 7; bit >= 0; bit--)
+        {
+            crc = ((crc << 1) ^ ((crc & 0x08) ? 0x03 : 0)) & 0x0F;
+            crc ^= (byte >> bit) & 0x01;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Décoder une trame complète
+ * @return false si le CRC ne correspond pas (frame non modifié)
+ */
+inline bool decodeBITalinoFrame(const uint8_t *data, int channels, BITalinoFrame &frame)
+{
+    const int length = bitalinoFrameBytes(channels);
+    const uint8_t *end = &data[length - 1];
+
+    if (bitalinoFrameCRC(data, length) != (end[0] & 0x0F))
+        return false;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.seq = end[0] >> 4;
+    for (int i = 0; i < 4; i++)
+        frame.digital[i] = (end[-1] >> (7 - i)) & 0x01;
+
+    if (channels > 0)
+        frame.analog[0] = ((end[-1] & 0x0F) << 6) | (end[-2] >> 2);
+    if (channels > 1)
+        frame.analog[1] = ((end[-2] & 0x03) << 8) | end[-3];
+    if (channels > 2)
+        frame.analog[2] = (end[-4] << 2) | (end[-5] >> 6);
+    if (channels > 3)
+        frame.analog[3] = ((end[-5] & 0x3F) << 4) | (end[-6] >> 4);
+    if (channels > 4)
+        frame.analog[4] = ((end[-6] & 0x0F) << 2) | (end[-7] >> 6);
+    if (channels > 5)
+        frame.analog[5] = end[-7] & 0x3F;
+
+    return true;
+}
+
+/**
+ * @brief Décodeur octet par octet d'un flux de trames à Channels voies
+ */
+template <int Channels>
+class BITalinoFrameDecoder
+{
+public:
+    static_assert(Channels >= 1 && Channels <= BITALINO_NUM_ANALOG_CHANNELS, "1 à 6 voies analogiques");
+
+    static const int FrameBytes = bitalinoFrameBytes(Channels);
+
+    BITalinoFrameDecoder() { reset(); }
+
+    /**
+     * @brief Nouveau flux (démarrage, reprise) : la première trame ne
+     *        compte pas comme un saut
+     */
+    void reset()
+    {
+        count = 0;
+        last_seq = -1;
+        crc_errors = 0;
+    }
+
+    /**
+     * @brief Ajouter un octet reçu
+     * @param frame Trame décodée quand la fonction renvoie true
+     * @param lost Trames perdues juste avant celle-ci (0 sans saut)
+     * @return true si une trame valide vient d'être complétée
+     */
+    bool push(uint8_t byte, BITalinoFrame &frame, int &lost)
+    {
+        buffer[count++] = byte;
+        if (count < FrameBytes)
+            return false;
+
+        if (!decodeBITalinoFrame(buffer, Channels, frame))
+        {
+            // Frontière de trame inconnue : glisser d'un octet
+            crc_errors++;
+            memmove(buffer, &buffer[1], FrameBytes - 1);
+            count--;
+            return false;
+        }
+
+        lost = last_seq < 0 ? 0 : (frame.seq - last_seq - 1) & 0x0F;
+        last_seq = frame.seq;
+        count = 0;
+        return true;
+    }
+
+    /**
+     * @brief Trames rejetées par le CRC depuis reset() (glissements compris)
+     */
+    unsigned long getCRCErrors() const { return crc_errors; }
+
+private:
+    uint8_t buffer[FrameBytes];
+    int count;
+    int last_seq;
+    unsigned long crc_errors;
+};
+
+#endif
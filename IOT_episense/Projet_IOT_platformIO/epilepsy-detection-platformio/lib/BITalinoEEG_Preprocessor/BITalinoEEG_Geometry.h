@@ -0,0 +1,71 @@
+/**
+ * @file BITalinoEEG_Geometry.h
+ * @brief Découpage de la fenêtre en segments, fixé à la compilation
+ *
+ * WINDOW_SIZE = 178 ne se divise pas en NUM_SEGMENTS = 7 : il reste
+ * 178 − 7 × 25 = 3 échantillons. Trois politiques, choisies par
+ * EEG_SEGMENT_REMAINDER :
+ *  - SEGMENT_REMAINDER_DROP (historique, défaut) : 7 segments de 25, le
+ *    reliquat n'appartient à aucun segment mais compte dans les features
+ *    de la fenêtre entière ;
+ *  - SEGMENT_REMAINDER_LAST : le dernier segment absorbe le reliquat (25 × 6 + 28) ;
+ *  - SEGMENT_REMAINDER_SPREAD : un échantillon de plus aux premiers segments
+ *    (26 × 3 + 25 × 4).
+ * Le nombre de features ne change pas ; LAST et SPREAD changent les valeurs
+ * des features de segment, le modèle doit être entraîné avec la même
+ * politique.
+ *
+ * Longueurs et débuts de segment sont constexpr : l'extracteur
+ * (TemporalFeatureSet::computeWindow) instancie un noyau par longueur.
+ */
+
+#ifndef BITALINO_EEG_GEOMETRY_H
+#define BITALINO_EEG_GEOMETRY_H
+
+#include "BITalinoEEG_Config.h"
+
+#define SEGMENT_REMAINDER_DROP 0
+#define SEGMENT_REMAINDER_LAST 1
+#define SEGMENT_REMAINDER_SPREAD 2
+
+#ifndef EEG_SEGMENT_REMAINDER
+#define EEG_SEGMENT_REMAINDER SEGMENT_REMAINDER_DROP
+#endif
+
+/**
+ * @brief Fenêtre de Length échantillons en Segments segments, reliquat selon Policy
+ */
+template <int Length, int Segments, int Policy>
+struct WindowGeometry
+{
+    static_assert(Segments >= 1 && Length >= 2 * Segments, "segments d'au moins 2 échantillons");
+    static_assert(Policy == SEGMENT_REMAINDER_DROP || Policy == SEGMENT_REMAINDER_LAST ||
+                      Policy == SEGMENT_REMAINDER_SPREAD,
+                  "politique de reliquat inconnue");
+
+    static const int WindowLength = Length;
+    static const int NumSegments = Segments;
+    static const int RemainderPolicy = Policy;
+    static const int BaseLength = Length / Segments;
+    static const int Remainder = Length - Segments * BaseLength;
+
+    static constexpr int segmentLength(int seg)
+    {
+        return Policy == SEGMENT_REMAINDER_LAST ? BaseLength + (seg == Segments - 1 ? Remainder : 0)
+               : Policy == SEGMENT_REMAINDER_SPREAD ? BaseLength + (seg < Remainder ? 1 : 0)
+                                                    : BaseLength;
+    }
+
+    static constexpr int segmentStart(int seg)
+    {
+        return Policy == SEGMENT_REMAINDER_SPREAD ? seg * BaseLength + (seg < Remainder ? seg : Remainder)
+                                                  : seg * BaseLength;
+    }
+
+    /** Échantillons couverts par les segments (Length sauf avec DROP) */
+    static const int Covered = Policy == SEGMENT_REMAINDER_DROP ? Segments * BaseLength : Length;
+};
+
+typedef WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, EEG_SEGMENT_REMAINDER> EEGWindowGeometry;
+
+#endif
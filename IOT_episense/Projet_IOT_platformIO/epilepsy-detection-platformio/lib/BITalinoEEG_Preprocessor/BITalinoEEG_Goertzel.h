@@ -0,0 +1,150 @@
+/**
+ * @file BITalinoEEG_Goertzel.h
+ * @brief Banc de Goertzel glissant pour quelques fréquences ciblées
+ *
+ * Chaque bin est un DFT glissant (forme récursive du premier ordre de
+ * Goertzel) sur les WINDOW_SIZE derniers échantillons :
+ *   X(n) = r·e^(2iπk/W)·X(n−1) + x[n] − r^W·x[n−W]
+ * La mise à jour coûte une rotation complexe par bin et par échantillon ;
+ * la magnitude est disponible dès qu'une fenêtre est complète, sans parcours
+ * supplémentaire du buffer.
+ *
+ * Avec WINDOW_SIZE = SAMPLE_RATE, l'espacement des bins vaut exactement
+ * 1 Hz : les fréquences sont donc des entiers en Hz, passés en paramètres
+ * template (un bin non listé ne coûte rien).
+ *
+ * Le facteur d'amortissement r = GOERTZEL_DAMPING borne l'erreur d'arrondi
+ * qui, sinon, s'accumule indéfiniment (|e^(iθ)| ≠ 1 en float). Le plus
+ * ancien échantillon de la fenêtre est pondéré par r^W ≈ 0.998.
+ */
+
+#ifndef BITALINO_EEG_GOERTZEL_H
+#define BITALINO_EEG_GOERTZEL_H
+
+#include <cmath>
+#include "BITalinoEEG_Config.h"
+
+#define GOERTZEL_DAMPING 0.99999
+
+/**
+ * @brief Vérifier que chaque fréquence tombe sur un bin (1 Hz à SAMPLE_RATE / 2)
+ */
+template <unsigned... FreqHz>
+constexpr bool goertzelBinsValid()
+{
+    const unsigned frequencies[] = {FreqHz...};
+    for (unsigned f : frequencies)
+    {
+        if (f == 0 || 2 * f >= SAMPLE_RATE || f * WINDOW_SIZE % SAMPLE_RATE != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Banc de DFT glissants aux fréquences FreqHz... (en Hz)
+ */
+template <unsigned... FreqHz>
+class GoertzelBank
+{
+public:
+    static const int NumBins = sizeof...(FreqHz);
+
+    static_assert(goertzelBinsValid<FreqHz...>(),
+                  "bins entre 1 Hz et SAMPLE_RATE / 2, sur la grille SAMPLE_RATE / WINDOW_SIZE");
+
+    GoertzelBank()
+    {
+        const unsigned frequencies[NumBins] = {FreqHz...};
+        for (int b = 0; b < NumBins; b++)
+        {
+            int k = frequencies[b] * WINDOW_SIZE / SAMPLE_RATE;
+            double angle = 2.0 * M_PI * k / WINDOW_SIZE;
+            rotation_re[b] = (float)(GOERTZEL_DAMPING * std::cos(angle));
+            rotation_im[b] = (float)(GOERTZEL_DAMPING * std::sin(angle));
+        }
+        leaving_weight = (float)std::pow(GOERTZEL_DAMPING, WINDOW_SIZE);
+        reset();
+    }
+
+    void reset()
+    {
+        for (int b = 0; b < NumBins; b++)
+        {
+            re[b] = 0;
+            im[b] = 0;
+        }
+    }
+
+    /**
+     * @brief Intégrer un échantillon
+     * @param entering Échantillon qui entre dans la fenêtre
+     * @param leaving Échantillon qui en sort (0 tant que la fenêtre se remplit)
+     */
+    void update(float entering, float leaving)
+    {
+        float delta = entering - leaving_weight * leaving;
+        for (int b = 0; b < NumBins; b++)
+        {
+            float r = re[b];
+            float i = im[b];
+            re[b] = rotation_re[b] * r - rotation_im[b] * i + delta;
+            im[b] = rotation_re[b] * i + rotation_im[b] * r;
+        }
+    }
+
+    static unsigned frequency(int bin)
+    {
+        const unsigned frequencies[NumBins] = {FreqHz...};
+        return frequencies[bin];
+    }
+
+    /**
+     * @brief Amplitude crête (µV) de la composante du bin sur la fenêtre
+     */
+    float magnitude(int bin) const
+    {
+        return 2.0f * std::sqrt(re[bin] * re[bin] + im[bin] * im[bin]) / WINDOW_SIZE;
+    }
+
+    /**
+     * @brief Puissance moyenne (µV²) de la composante du bin sur la fenêtre
+     */
+    float power(int bin) const
+    {
+        float amplitude = magnitude(bin);
+        return 0.5f * amplitude * amplitude;
+    }
+
+private:
+    float re[NumBins];
+    float im[NumBins];
+    float rotation_re[NumBins];
+    float rotation_im[NumBins];
+    float leaving_weight;
+};
+
+/**
+ * @brief Banc vide : aucune mise à jour, aucun stockage
+ */
+template <>
+class GoertzelBank<>
+{
+public:
+    static const int NumBins = 0;
+
+    void reset() {}
+    void update(float, float) {}
+    static unsigned frequency(int) { return 0; }
+    float magnitude(int) const { return 0; }
+    float power(int) const { return 0; }
+};
+
+// Bins du préprocesseur : pointe-onde à 3 Hz, secteur à 50 Hz
+#ifndef EEG_GOERTZEL_BINS
+#define EEG_GOERTZEL_BINS 3, 50
+#endif
+
+typedef GoertzelBank<EEG_GOERTZEL_BINS> EEGGoertzelBank;
+
+#endif
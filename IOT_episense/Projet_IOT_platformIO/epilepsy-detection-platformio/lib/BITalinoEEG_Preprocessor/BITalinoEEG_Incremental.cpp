@@ -0,0 +1,215 @@
+/**
+ * @file BITalinoEEG_Incremental.cpp
+ * @brief Implémentation du moteur de features incrémental
+ *
+ */
+
+#include "BITalinoEEG_Incremental.h"
+#include <cmath>
+#include <cstring>
+
+template <int Length>
+void SlidingStats<Length>::addPowers(float x, float sign)
+{
+    float d = x - origin;
+    float d_sq = d * d;
+    s1.add(sign * d);
+    s2.add(sign * d_sq);
+    s3.add(sign * d_sq * d);
+    s4.add(sign * d_sq * d_sq);
+}
+
+template <int Length>
+void SlidingStats<Length>::rebuild(const float *data, const float *entropy_terms, uint32_t first_index)
+{
+    float sum = 0;
+    for (int i = 0; i < Length; i++)
+    {
+        sum += data[i];
+    }
+    origin = sum / Length;
+
+    s1.clear();
+    s2.clear();
+    s3.clear();
+    s4.clear();
+    abs_diff.clear();
+    sq_diff.clear();
+    entropy.clear();
+    zero_crossings = 0;
+    min_deque.clear();
+    max_deque.clear();
+    median_window.clear();
+
+    for (int i = 0; i < Length; i++)
+    {
+        addPowers(data[i], 1.0f);
+        entropy.add(entropy_terms[i]);
+        min_deque.push(first_index + i, data[i]);
+        max_deque.push(first_index + i, data[i]);
+        median_window.push(data[i]);
+
+        if (i > 0)
+        {
+            float diff = std::abs(data[i] - data[i - 1]);
+            abs_diff.add(diff);
+            sq_diff.add(diff * diff);
+            if ((data[i - 1] < 0) != (data[i] < 0))
+                zero_crossings++;
+        }
+    }
+}
+
+template <int Length>
+void SlidingStats<Length>::slide(float in, float in_prev, float in_entropy, uint32_t in_index,
+                                 float out, float out_next, float out_entropy)
+{
+    addPowers(in, 1.0f);
+    addPowers(out, -1.0f);
+
+    float diff_in = std::abs(in - in_prev);
+    float diff_out = std::abs(out_next - out);
+    abs_diff.add(diff_in);
+    abs_diff.add(-diff_out);
+    sq_diff.add(diff_in * diff_in);
+    sq_diff.add(-diff_out * diff_out);
+
+    if ((in_prev < 0) != (in < 0))
+        zero_crossings++;
+    if ((out < 0) != (out_next < 0))
+        zero_crossings--;
+
+    entropy.add(in_entropy);
+    entropy.add(-out_entropy);
+
+    uint32_t oldest = in_index - (Length - 1);
+    min_deque.expire(oldest);
+    max_deque.expire(oldest);
+    min_deque.push(in_index, in);
+    max_deque.push(in_index, in);
+    median_window.push(in);
+}
+
+template <int Length>
+void SlidingStats<Length>::toSegmentStats(SegmentStats &stats) const
+{
+    const float n = Length;
+    float delta = s1.sum / n;
+    float delta_sq = delta * delta;
+    float mean = origin + delta;
+
+    float m2 = s2.sum - n * delta_sq;
+    float m3 = s3.sum - 3.0f * delta * s2.sum + 2.0f * n * delta_sq * delta;
+    float m4 = s4.sum - 4.0f * delta * s3.sum + 6.0f * delta_sq * s2.sum - 3.0f * n * delta_sq * delta_sq;
+
+    float diff_dev = sq_diff.sum - abs_diff.sum * abs_diff.sum / (Length - 1);
+
+    stats.length = Length;
+    stats.sum = mean * n;
+    stats.sum_sq = s2.sum + 2.0f * origin * s1.sum + n * origin * origin;
+    stats.min = min_deque.front();
+    stats.max = max_deque.front();
+    stats.median = median_window.median();
+    stats.m2 = m2 > 0 ? m2 : 0;
+    stats.m3 = m3;
+    stats.m4 = m4 > 0 ? m4 : 0;
+    stats.abs_diff_sum = abs_diff.sum;
+    stats.abs_diff_dev_sq = diff_dev > 0 ? diff_dev : 0;
+    stats.zero_crossings = zero_crossings;
+    stats.entropy_sum = entropy.sum;
+    stats.diff2_sq_sum = 0;
+    stats.tkeo_sum = 0;
+}
+
+template class SlidingStats<WINDOW_SIZE>;
+template class SlidingStats<SEGMENT_SIZE>;
+
+IncrementalFeatureEngine::IncrementalFeatureEngine()
+{
+    reset();
+}
+
+void IncrementalFeatureEngine::reset()
+{
+    memset(entropy_terms, 0, sizeof(entropy_terms));
+    term_index = 0;
+    sample_index = 0;
+    anchored = false;
+}
+
+float IncrementalFeatureEngine::entropyTerm(float x)
+{
+    float p = std::abs(x) + 1e-8;
+    return p * eegLog(p);
+}
+
+void IncrementalFeatureEngine::anchor(const float *window)
+{
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        float term = entropyTerm(window[i]);
+        entropy_terms[i] = term;
+        entropy_terms[i + WINDOW_SIZE] = term;
+    }
+    term_index = 0;
+
+    uint32_t first_index = sample_index - (WINDOW_SIZE - 1);
+
+    window_stats.rebuild(window, entropy_terms, first_index);
+    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+    {
+        int base = seg * SEGMENT_SIZE;
+        segment_stats[seg].rebuild(&window[base], &entropy_terms[base], first_index + base);
+    }
+
+    anchored = true;
+}
+
+void IncrementalFeatureEngine::update(const float *window, float leaving)
+{
+    sample_index++;
+
+    if (!anchored)
+    {
+        return;
+    }
+
+    float entering = window[WINDOW_SIZE - 1];
+    float entering_term = entropyTerm(entering);
+    float leaving_term = entropy_terms[term_index];
+
+    entropy_terms[term_index] = entering_term;
+    entropy_terms[term_index + WINDOW_SIZE] = entering_term;
+    if (++term_index == WINDOW_SIZE)
+    {
+        term_index = 0;
+    }
+
+    const float *terms = &entropy_terms[term_index];
+    uint32_t first_index = sample_index - (WINDOW_SIZE - 1);
+
+    window_stats.slide(entering, window[WINDOW_SIZE - 2], entering_term, sample_index,
+                       leaving, window[0], leaving_term);
+
+    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+    {
+        int base = seg * SEGMENT_SIZE;
+        int last = base + SEGMENT_SIZE - 1;
+
+        float out = seg == 0 ? leaving : window[base - 1];
+        float out_term = seg == 0 ? leaving_term : terms[base - 1];
+
+        segment_stats[seg].slide(window[last], window[last - 1], terms[last], first_index + last,
+                                 out, window[base], out_term);
+    }
+}
+
+void IncrementalFeatureEngine::getWindowStats(SegmentStats &stats) const
+{
+    window_stats.toSegmentStats(stats);
+}
+
+void IncrementalFeatureEngine::getSegmentStats(int segment, SegmentStats &stats) const
+{
+    segment_stats[segment].toSegmentStats(stats);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file BITalinoEEG_Incremental.h
+ * @brief Moteur de features incrémental pour fenêtres glissantes
+ *
+ * Avec des fenêtres qui se recouvrent, les statistiques de la fenêtre et des
+ * 7 segments sont mises à jour à chaque échantillon : on ajoute l'échantillon
+ * qui entre et on retire celui qui sort, au lieu de tout recalculer. Le coût
+ * par décision devient O(hop) au lieu de O(fenêtre).
+ *
+ * - Sommes de puissances (x, x², x³, x⁴) relatives à une origine fixée au
+ *   dernier ré-ancrage, en sommation compensée (Kahan) ;
+ * - Min / max par files monotones (amorti O(1)) ;
+ * - Médiane par double tas indexé (O(log n), voir BITalinoEEG_Median.h) ;
+ * - Les moments centrés sont reconstruits à partir des sommes au moment de
+ *   l'extraction ;
+ * - Ré-ancrage périodique sur le calcul exact pour borner la dérive float.
+ *
+ * Le coût par échantillon est constant (8 mises à jour), le mode est donc
+ * rentable lorsque le hop est petit devant la fenêtre (recouvrement >= ~75%).
+ *
+ * Différences secondes et Teager–Kaiser ne sont pas suivis (valent 0) : le
+ * préprocesseur n'active pas ce mode si son masque en a besoin.
+ *
+ * Note : la sommation compensée suppose une compilation sans -ffast-math.
+ */
+
+#ifndef BITALINO_EEG_INCREMENTAL_H
+#define BITALINO_EEG_INCREMENTAL_H
+
+#include <stdint.h>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_Median.h"
+
+#ifndef INCREMENTAL_ANCHOR_INTERVAL
+#define INCREMENTAL_ANCHOR_INTERVAL 64
+#endif
+
+/**
+ * @brief Accumulateur à sommation compensée (Kahan)
+ */
+struct KahanAccumulator
+{
+    float sum;
+    float compensation;
+
+    void clear()
+    {
+        sum = 0;
+        compensation = 0;
+    }
+
+    void add(float value)
+    {
+        float y = value - compensation;
+        float t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+};
+
+/**
+ * @brief File monotone pour min (IsMax = false) ou max (IsMax = true) glissant
+ *
+ * Les indices sont des compteurs d'échantillons absolus sur 32 bits ;
+ * les comparaisons sont robustes au rebouclage.
+ */
+template <int Capacity, bool IsMax>
+class MonotonicDeque
+{
+public:
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    void push(uint32_t index, float value)
+    {
+        while (count > 0)
+        {
+            float back = entries[wrap(head + count - 1)].value;
+            if (IsMax ? (back > value) : (back < value))
+                break;
+            count--;
+        }
+        entries[wrap(head + count)] = {index, value};
+        count++;
+    }
+
+    void expire(uint32_t oldest_index)
+    {
+        while (count > 0 && (int32_t)(entries[head].index - oldest_index) < 0)
+        {
+            head = wrap(head + 1);
+            count--;
+        }
+    }
+
+    float front() const { return entries[head].value; }
+
+private:
+    struct Entry
+    {
+        uint32_t index;
+        float value;
+    };
+
+    static int wrap(int i) { return i >= Capacity ? i - Capacity : i; }
+
+    Entry entries[Capacity];
+    int head;
+    int count;
+};
+
+/**
+ * @brief Statistiques glissantes sur les Length derniers échantillons
+ */
+template <int Length>
+class SlidingStats
+{
+public:
+    /**
+     * @brief Reconstruire exactement les accumulateurs depuis les données
+     * @param data Length échantillons, du plus ancien au plus récent
+     * @param entropy_terms Termes |x|log|x| associés
+     * @param first_index Indice absolu de data[0]
+     */
+    void rebuild(const float *data, const float *entropy_terms, uint32_t first_index);
+
+    /**
+     * @brief Faire glisser d'un échantillon
+     * @param in Échantillon entrant, in_prev son prédécesseur (déjà dans la fenêtre)
+     * @param out Échantillon sortant, out_next son successeur (reste dans la fenêtre)
+     */
+    void slide(float in, float in_prev, float in_entropy, uint32_t in_index,
+               float out, float out_next, float out_entropy);
+
+    /**
+     * @brief Convertir en statistiques de segment
+     */
+    void toSegmentStats(SegmentStats &stats) const;
+
+private:
+    float origin;
+
+    KahanAccumulator s1;
+    KahanAccumulator s2;
+    KahanAccumulator s3;
+    KahanAccumulator s4;
+    KahanAccumulator abs_diff;
+    KahanAccumulator sq_diff;
+    KahanAccumulator entropy;
+    int zero_crossings;
+
+    MonotonicDeque<Length, false> min_deque;
+    MonotonicDeque<Length, true> max_deque;
+    SlidingMedian<Length> median_window;
+
+    void addPowers(float x, float sign);
+};
+
+/**
+ * @brief Statistiques incrémentales de la fenêtre complète et des segments
+ */
+class IncrementalFeatureEngine
+{
+public:
+    IncrementalFeatureEngine();
+
+    void reset();
+
+    bool isAnchored() const { return anchored; }
+
+    /**
+     * @brief Ré-ancrer : recalcul exact de tous les accumulateurs
+     * @param window Fenêtre courante (WINDOW_SIZE échantillons)
+     */
+    void anchor(const float *window);
+
+    /**
+     * @brief Intégrer le dernier échantillon écrit dans la fenêtre
+     * @param window Fenêtre courante, window[WINDOW_SIZE - 1] vient d'entrer
+     * @param leaving Échantillon qui vient de sortir de la fenêtre
+     */
+    void update(const float *window, float leaving);
+
+    void getWindowStats(SegmentStats &stats) const;
+    void getSegmentStats(int segment, SegmentStats &stats) const;
+
+    static float entropyTerm(float x);
+
+private:
+    SlidingStats<WINDOW_SIZE> window_stats;
+    SlidingStats<SEGMENT_SIZE> segment_stats[NUM_SEGMENTS];
+
+    // Termes d'entropie mis en cache (buffer miroir, aligné sur la fenêtre)
+    float entropy_terms[2 * WINDOW_SIZE];
+    int term_index;
+
+    uint32_t sample_index;
+    bool anchored;
+};
+
+#endif
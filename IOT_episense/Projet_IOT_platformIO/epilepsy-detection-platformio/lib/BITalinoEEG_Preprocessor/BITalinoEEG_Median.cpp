@@ -0,0 +1,131 @@
+/**
+ * @file BITalinoEEG_Median.cpp
+ * @brief Implémentation de la médiane glissante indexée
+ *
+ * heap(0) est la médiane, heap(1..) le tas min, heap(-1..) le tas max.
+ */
+
+#include "BITalinoEEG_Median.h"
+#include "BITalinoEEG_Config.h"
+
+template <int Length>
+SlidingMedian<Length>::SlidingMedian()
+{
+    clear();
+}
+
+template <int Length>
+void SlidingMedian<Length>::clear()
+{
+    index = 0;
+    count = 0;
+    for (int i = Length - 1; i >= 0; i--)
+    {
+        values[i] = 0;
+        pos[i] = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+        heap(pos[i]) = i;
+    }
+}
+
+template <int Length>
+bool SlidingMedian<Length>::exchange(int i, int j)
+{
+    int16_t t = heap(i);
+    heap(i) = heap(j);
+    heap(j) = t;
+    pos[heap(i)] = i;
+    pos[heap(j)] = j;
+    return true;
+}
+
+template <int Length>
+void SlidingMedian<Length>::minSortDown(int i)
+{
+    for (; i <= minCount(); i *= 2)
+    {
+        if (i > 1 && i < minCount() && less(i + 1, i))
+            ++i;
+        if (!compareExchange(i, i / 2))
+            break;
+    }
+}
+
+template <int Length>
+void SlidingMedian<Length>::maxSortDown(int i)
+{
+    for (; i >= -maxCount(); i *= 2)
+    {
+        if (i < -1 && i > -maxCount() && less(i, i - 1))
+            --i;
+        if (!compareExchange(i / 2, i))
+            break;
+    }
+}
+
+template <int Length>
+bool SlidingMedian<Length>::minSortUp(int i)
+{
+    while (i > 0 && compareExchange(i, i / 2))
+        i /= 2;
+    return i == 0;
+}
+
+template <int Length>
+bool SlidingMedian<Length>::maxSortUp(int i)
+{
+    while (i < 0 && compareExchange(i / 2, i))
+        i /= 2;
+    return i == 0;
+}
+
+template <int Length>
+void SlidingMedian<Length>::push(float value)
+{
+    bool is_new = count < Length;
+    int p = pos[index];
+    float old = values[index];
+
+    values[index] = value;
+    if (++index == Length)
+        index = 0;
+    count += is_new;
+
+    if (p > 0)
+    {
+        // Valeur dans le tas min
+        if (!is_new && old < value)
+            minSortDown(p * 2);
+        else if (minSortUp(p))
+            maxSortDown(-1);
+    }
+    else if (p < 0)
+    {
+        // Valeur dans le tas max
+        if (!is_new && value < old)
+            maxSortDown(p * 2);
+        else if (maxSortUp(p))
+            minSortDown(1);
+    }
+    else
+    {
+        // Valeur à la position médiane
+        if (maxCount())
+            maxSortDown(-1);
+        if (minCount())
+            minSortDown(1);
+    }
+}
+
+template <int Length>
+float SlidingMedian<Length>::median() const
+{
+    float upper = values[heap(0)];
+    if ((count & 1) == 0)
+    {
+        return (values[heap(-1)] + upper) / 2.0f;
+    }
+    return upper;
+}
+
+template class SlidingMedian<WINDOW_SIZE>;
+template class SlidingMedian<SEGMENT_SIZE>;
@@ -0,0 +1,65 @@
+/**
+ * @file BITalinoEEG_Median.h
+ * @brief Médiane glissante indexée (double tas min / max)
+ *
+ * Structure "mediator" : un tas max (moitié basse) et un tas min (moitié
+ * haute) partagent un même tableau centré sur la médiane. Chaque valeur de
+ * la fenêtre connaît sa position dans le tas, ce qui permet de remplacer
+ * directement l'échantillon le plus ancien par le nouveau en O(log n),
+ * sans recherche ni tri. Mémoire fixe : Length × (4 + 2 + 2) octets.
+ */
+
+#ifndef BITALINO_EEG_MEDIAN_H
+#define BITALINO_EEG_MEDIAN_H
+
+#include <stdint.h>
+
+template <int Length>
+class SlidingMedian
+{
+public:
+    SlidingMedian();
+
+    /**
+     * @brief Vider la fenêtre
+     */
+    void clear();
+
+    /**
+     * @brief Insérer un échantillon ; une fois la fenêtre pleine, il
+     *        remplace l'échantillon le plus ancien
+     */
+    void push(float value);
+
+    /**
+     * @brief Médiane courante (moyenne des deux valeurs centrales si le
+     *        nombre d'échantillons est pair, comme le calcul par tri)
+     */
+    float median() const;
+
+private:
+    float values[Length];
+    int16_t pos[Length];
+    int16_t heap_storage[Length];
+    int index;
+    int count;
+
+    // Tas centré sur la médiane (indices négatifs : tas max). Accès par
+    // décalage plutôt que par pointeur interne : l'objet reste copiable
+    int16_t &heap(int i) { return heap_storage[i + Length / 2]; }
+    int16_t heap(int i) const { return heap_storage[i + Length / 2]; }
+
+    int minCount() const { return (count - 1) / 2; }
+    int maxCount() const { return count / 2; }
+
+    bool less(int i, int j) const { return values[heap(i)] < values[heap(j)]; }
+    bool exchange(int i, int j);
+    bool compareExchange(int i, int j) { return less(i, j) && exchange(i, j); }
+
+    void minSortDown(int i);
+    void maxSortDown(int i);
+    bool minSortUp(int i);
+    bool maxSortUp(int i);
+};
+
+#endif
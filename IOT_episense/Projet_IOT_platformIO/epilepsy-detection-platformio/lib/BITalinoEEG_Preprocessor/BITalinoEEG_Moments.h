@@ -0,0 +1,230 @@
+/**
+ * @file BITalinoEEG_Moments.h
+ * @brief Statistiques suffisantes fusionnables (Welford / Chan / Pébay)
+ *
+ * MomentAccumulator résume une suite contiguë d'échantillons : effectif,
+ * somme, énergie, min / max, moments centrés M2..M4, différences absolues
+ * (somme et M2), passages par zéro, somme d'entropie, différences secondes
+ * et Teager–Kaiser, deux premiers et deux derniers échantillons. Deux suites
+ * consécutives se combinent par merge() sans revisiter les données :
+ *   δ = moy_b − moy_a, n = n_a + n_b
+ *   M2 = M2a + M2b + δ²·n_a·n_b / n
+ *   M3 = M3a + M3b + δ³·n_a·n_b·(n_a − n_b) / n² + 3δ·(n_a·M2b − n_b·M2a) / n
+ *   M4 = M4a + M4b + δ⁴·n_a·n_b·(n_a² − n_a·n_b + n_b²) / n³
+ *        + 6δ²·(n_a²·M2b + n_b²·M2a) / n² + 4δ·(n_a·M3b − n_b·M3a) / n
+ * La différence, le passage par zéro et les termes centrés sur les deux
+ * échantillons de jonction (différence seconde, Teager–Kaiser) sont ajoutés
+ * à partir des échantillons de bord. La médiane n'est pas fusionnable.
+ *
+ * add() fait la même mise à jour pour un échantillon isolé (flux continu).
+ */
+
+#ifndef BITALINO_EEG_MOMENTS_H
+#define BITALINO_EEG_MOMENTS_H
+
+#include <cmath>
+#include "BITalinoEEG_Features.h"
+
+struct MomentAccumulator
+{
+    int count;
+
+    float sum;
+    float sum_sq;
+    float min;
+    float max;
+
+    float m2;
+    float m3;
+    float m4;
+
+    float abs_diff_sum;
+    float abs_diff_m2;
+    int zero_crossings;
+    float entropy_sum;
+    float diff2_sq_sum;
+    float tkeo_sum;
+
+    float first;
+    float second;
+    float penultimate;
+    float last;
+
+    void reset()
+    {
+        count = 0;
+        sum = 0;
+        sum_sq = 0;
+        min = 0;
+        max = 0;
+        m2 = 0;
+        m3 = 0;
+        m4 = 0;
+        abs_diff_sum = 0;
+        abs_diff_m2 = 0;
+        zero_crossings = 0;
+        entropy_sum = 0;
+        diff2_sq_sum = 0;
+        tkeo_sum = 0;
+        first = 0;
+        second = 0;
+        penultimate = 0;
+        last = 0;
+    }
+
+    /**
+     * @brief Reprendre les statistiques d'un segment (computeSegmentStats*)
+     * @param data Échantillons du segment (seuls les deux premiers et les
+     *             deux derniers sont lus)
+     */
+    void assign(const SegmentStats &stats, const float *data)
+    {
+        count = stats.length;
+        sum = stats.sum;
+        sum_sq = stats.sum_sq;
+        min = stats.min;
+        max = stats.max;
+        m2 = stats.m2;
+        m3 = stats.m3;
+        m4 = stats.m4;
+        abs_diff_sum = stats.abs_diff_sum;
+        abs_diff_m2 = stats.abs_diff_dev_sq;
+        zero_crossings = stats.zero_crossings;
+        entropy_sum = stats.entropy_sum;
+        diff2_sq_sum = stats.diff2_sq_sum;
+        tkeo_sum = stats.tkeo_sum;
+        first = data[0];
+        second = data[1];
+        penultimate = data[stats.length - 2];
+        last = data[stats.length - 1];
+    }
+
+    /**
+     * @brief Ajouter un échantillon à la fin de la suite
+     */
+    void add(float x)
+    {
+        MomentAccumulator single;
+        float p = std::abs(x) + 1e-8;
+
+        single.reset();
+        single.count = 1;
+        single.sum = x;
+        single.sum_sq = x * x;
+        single.min = x;
+        single.max = x;
+        single.entropy_sum = p * eegLog(p);
+        single.first = x;
+        single.second = x;
+        single.penultimate = x;
+        single.last = x;
+        merge(single);
+    }
+
+    /**
+     * @brief Ajouter la suite next, qui suit immédiatement celle-ci
+     */
+    void merge(const MomentAccumulator &next)
+    {
+        if (next.count == 0)
+            return;
+        if (count == 0)
+        {
+            *this = next;
+            return;
+        }
+
+        const float na = count;
+        const float nb = next.count;
+        const float n = na + nb;
+        const float delta = next.sum / nb - sum / na;
+        const float delta_sq = delta * delta;
+
+        m4 += next.m4 + delta_sq * delta_sq * na * nb * (na * na - na * nb + nb * nb) / (n * n * n) +
+              6 * delta_sq * (na * na * next.m2 + nb * nb * m2) / (n * n) +
+              4 * delta * (na * next.m3 - nb * m3) / n;
+        m3 += next.m3 + delta_sq * delta * na * nb * (na - nb) / (n * n) +
+              3 * delta * (na * next.m2 - nb * m2) / n;
+        m2 += next.m2 + delta_sq * na * nb / n;
+
+        // Différences absolues : suite a, différence de jonction, suite b
+        float junction = std::abs(next.first - last);
+        mergeDiffMoments(count - 1, abs_diff_sum, abs_diff_m2, 1, junction, 0);
+        mergeDiffMoments(count, abs_diff_sum, abs_diff_m2, next.count - 1, next.abs_diff_sum, next.abs_diff_m2);
+
+        zero_crossings += next.zero_crossings + ((last < 0) != (next.first < 0) ? 1 : 0);
+
+        // Termes centrés sur last (si a a un prédécesseur) et sur next.first
+        // (si b a un successeur)
+        diff2_sq_sum += next.diff2_sq_sum;
+        tkeo_sum += next.tkeo_sum;
+        if (count >= 2)
+        {
+            float diff2 = next.first - 2 * last + penultimate;
+            diff2_sq_sum += diff2 * diff2;
+            tkeo_sum += last * last - penultimate * next.first;
+        }
+        if (next.count >= 2)
+        {
+            float diff2 = next.second - 2 * next.first + last;
+            diff2_sq_sum += diff2 * diff2;
+            tkeo_sum += next.first * next.first - last * next.second;
+        }
+        if (count == 1)
+            second = next.first;
+        penultimate = next.count >= 2 ? next.penultimate : last;
+
+        count += next.count;
+        sum += next.sum;
+        sum_sq += next.sum_sq;
+        if (next.min < min)
+            min = next.min;
+        if (next.max > max)
+            max = next.max;
+        entropy_sum += next.entropy_sum;
+        last = next.last;
+    }
+
+    /**
+     * @brief Convertir en SegmentStats (median à renseigner par l'appelant)
+     */
+    void toSegmentStats(SegmentStats &stats) const
+    {
+        stats.length = count;
+        stats.sum = sum;
+        stats.sum_sq = sum_sq;
+        stats.min = min;
+        stats.max = max;
+        stats.median = 0;
+        stats.m2 = m2;
+        stats.m3 = m3;
+        stats.m4 = m4;
+        stats.abs_diff_sum = abs_diff_sum;
+        stats.abs_diff_dev_sq = abs_diff_m2;
+        stats.zero_crossings = zero_crossings;
+        stats.entropy_sum = entropy_sum;
+        stats.diff2_sq_sum = diff2_sq_sum;
+        stats.tkeo_sum = tkeo_sum;
+    }
+
+private:
+    // Chan : (count_a, sum_a, m2_a) += (count_b, sum_b, m2_b)
+    static void mergeDiffMoments(int count_a, float &sum_a, float &m2_a,
+                                 int count_b, float sum_b, float m2_b)
+    {
+        if (count_b <= 0)
+            return;
+        if (count_a > 0)
+        {
+            float delta = sum_b / count_b - sum_a / count_a;
+            m2_a += m2_b + delta * delta * count_a * count_b / (float)(count_a + count_b);
+        }
+        else
+        {
+            m2_a = m2_b;
+        }
+        sum_a += sum_b;
+    }
+};
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @file BITalinoEEG_MultiChannel.h
+ * @brief Préprocesseur multi-voies (jusqu'aux 6 entrées analogiques BITalino)
+ *
+ * Une seule instance traite Channels voies échantillonnées ensemble :
+ *  - buffers en structure de tableaux : une fenêtre miroir contiguë par voie,
+ *    directement utilisable par les noyaux de features ;
+ *  - état de filtre rangé par section puis par voie : une boucle fait avancer
+ *    toutes les voies à chaque trame (MultiChannelBiquadCascade) ;
+ *  - features de chaque voie écrites en blocs consécutifs d'un seul tableau
+ *    (voie c à partir de c × getChannelFeatureCount()).
+ *
+ * Chaîne float uniquement, sans mode incrémental ni banc de Goertzel : la
+ * voie EEG principale reste servie par BITalinoEEGPreprocessor. Une voie
+ * dont le signal ne doit pas passer le passe-bande EEG (EDA, accéléromètre)
+ * peut le contourner avec setChannelFiltered().
+ */
+
+#ifndef BITALINO_EEG_MULTICHANNEL_H
+#define BITALINO_EEG_MULTICHANNEL_H
+
+#include <algorithm>
+#include "BITalinoEEG_Preprocessor.h"
+
+template <int Channels>
+class BITalinoMultiChannelPreprocessor
+{
+public:
+    static const int NumChannels = Channels;
+
+    static_assert(Channels >= 1 && Channels <= BITALINO_NUM_ANALOG_CHANNELS,
+                  "BITalino : 1 à 6 entrées analogiques");
+
+    BITalinoMultiChannelPreprocessor()
+    {
+        hop_size = HOP_SIZE;
+        feature_groups = 0;
+        for (int c = 0; c < Channels; c++)
+        {
+            filtered_channel[c] = true;
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        write_index = 0;
+        samples_buffered = 0;
+        samples_since_window = 0;
+
+        memset(raw_buffer, 0, sizeof(raw_buffer));
+        memset(filtered_buffer, 0, sizeof(filtered_buffer));
+        memset(features, 0, sizeof(features));
+
+        bandpass.reset();
+    }
+
+    /**
+     * @brief Configurer le pas (hop) entre deux fenêtres
+     * @param hop_size Nombre de nouvelles trames par décision (1-WINDOW_SIZE)
+     */
+    void setHopSize(int new_hop_size)
+    {
+        hop_size = std::max(1, std::min(new_hop_size, WINDOW_SIZE));
+    }
+
+    int getHopSize() const { return hop_size; }
+
+    /**
+     * @brief Appliquer ou non le passe-bande EEG à une voie
+     * @param channel Indice de la voie (0 à Channels − 1)
+     * @param filtered false : la fenêtre filtrée est la copie de la fenêtre brute
+     */
+    void setChannelFiltered(int channel, bool filtered)
+    {
+        filtered_channel[channel] = filtered;
+    }
+
+    /**
+     * @brief Choisir les groupes de features (communs à toutes les voies)
+     * @param groups Combinaison de FEATURE_GROUP_* (0 : temporel seul)
+     */
+    void setFeatureGroups(unsigned groups) { feature_groups = groups & FEATURE_GROUPS_ALL; }
+
+    unsigned getFeatureGroups() const { return feature_groups; }
+
+    /**
+     * @brief Choisir une version historique du bloc de features
+     * @param layout FEATURE_LAYOUT_TEMPORAL, FEATURE_LAYOUT_SPECTRAL,
+     *        FEATURE_LAYOUT_WAVELET ou FEATURE_LAYOUT_COMPLEXITY
+     */
+    void setFeatureLayout(int layout) { setFeatureGroups(featureLayoutGroups(layout)); }
+
+    /**
+     * @brief Nombre de features par voie pour les groupes courants
+     */
+    int getChannelFeatureCount() const { return featureGroupsCount(feature_groups); }
+
+    int getFeatureCount() const { return Channels * getChannelFeatureCount(); }
+
+    /**
+     * @brief Ajouter une trame (une valeur ADC par voie)
+     * @param adc_values Channels valeurs ADC (0-1023)
+     * @return true si une fenêtre complète est prête
+     */
+    bool addFrame(const int *adc_values)
+    {
+        float microvolts[Channels];
+        float filtered[Channels];
+
+        for (int c = 0; c < Channels; c++)
+        {
+            microvolts[c] = adcToMicrovolts(adc_values[c]);
+        }
+
+        bandpass.processFrame(microvolts, filtered);
+
+        for (int c = 0; c < Channels; c++)
+        {
+            float value = filtered_channel[c] ? filtered[c] : microvolts[c];
+
+            raw_buffer[c][write_index] = microvolts[c];
+            raw_buffer[c][write_index + WINDOW_SIZE] = microvolts[c];
+            filtered_buffer[c][write_index] = value;
+            filtered_buffer[c][write_index + WINDOW_SIZE] = value;
+        }
+
+        if (++write_index == WINDOW_SIZE)
+        {
+            write_index = 0;
+        }
+
+        if (samples_buffered < WINDOW_SIZE)
+        {
+            if (++samples_buffered < WINDOW_SIZE)
+            {
+                return false;
+            }
+            samples_since_window = 0;
+            return true;
+        }
+
+        if (++samples_since_window < hop_size)
+        {
+            return false;
+        }
+        samples_since_window = 0;
+        return true;
+    }
+
+    /**
+     * @brief Ajouter count trames entrelacées (trame i : adc_frames[i × Channels ...])
+     * @return Nombre de trames consommées : s'arrête juste après la première
+     *         fenêtre complétée, comme BITalinoEEGPreprocessor::addSamples()
+     */
+    size_t addFrames(const int *adc_frames, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (addFrame(&adc_frames[i * Channels]))
+            {
+                return i + 1;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Fenêtre filtrée courante d'une voie (WINDOW_SIZE échantillons contigus)
+     */
+    const float *getWindow(int channel) const { return &filtered_buffer[channel][write_index]; }
+
+    /**
+     * @brief Fenêtre brute (µV) courante d'une voie
+     */
+    const float *getRawWindow(int channel) const { return &raw_buffer[channel][write_index]; }
+
+    /**
+     * @brief Extraire les features de toutes les voies
+     * @return true si l'extraction a réussi
+     */
+    bool extractFeatures()
+    {
+        const int block = getChannelFeatureCount();
+
+        for (int c = 0; c < Channels; c++)
+        {
+            const float *window = getWindow(c);
+            float *out = &features[c * block];
+
+            EEGTemporalFeatureSet::computeWindow(window, out);
+            out += NUM_TEMPORAL_LAYOUT_FEATURES;
+
+            if (feature_groups & FEATURE_GROUP_SPECTRAL)
+            {
+                computeSpectralFeatures(window, out);
+                out += NUM_SPECTRAL_FEATURES;
+            }
+
+            if (feature_groups & FEATURE_GROUP_WAVELET)
+            {
+                computeWaveletFeatures(window, out);
+                out += NUM_WAVELET_FEATURES;
+            }
+
+            if (feature_groups & FEATURE_GROUP_COMPLEXITY)
+            {
+                computeComplexityFeatures(window, out);
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Features de toutes les voies (getFeatureCount() éléments)
+     */
+    const float *getFeatures() const { return features; }
+
+    /**
+     * @brief Bloc de features d'une voie (getChannelFeatureCount() éléments)
+     */
+    const float *getChannelFeatures(int channel) const { return &features[channel * getChannelFeatureCount()]; }
+
+private:
+    // Buffers circulaires miroirs, un par voie (voir BITalinoEEGPreprocessor)
+    float raw_buffer[Channels][2 * WINDOW_SIZE];
+    float filtered_buffer[Channels][2 * WINDOW_SIZE];
+    float features[Channels * MAX_FEATURES];
+    unsigned feature_groups;
+
+    MultiChannelBiquadCascade<BANDPASS_NUM_SECTIONS, Channels> bandpass;
+    bool filtered_channel[Channels];
+
+    int write_index;
+    int samples_buffered;
+    int samples_since_window;
+    int hop_size;
+};
+
+#endif
@@ -9,361 +9,538 @@
 #include <cmath>
 #include <algorithm>
 
-#define BITALINO_ADC_RESOLUTION 1024.0f
-#define BITALINO_VCC 3.3f
-#define EEG_VCC_HALF 1.65f
-#define EEG_GAIN 1000.0f
-#define OVERLAP_SIZE (WINDOW_SIZE * OVERLAP_PERCENTAGE / 100)
+// Le scaler couvre un préfixe du bloc temporel (fenêtre puis segments)
+static_assert(NUM_FEATURES <= NUM_TEMPORAL_LAYOUT_FEATURES,
+              "scaler_params.h : plus de features que le bloc temporel n'en produit");
+#ifdef SCALER_TEMPORAL_FEATURE_MASK
+static_assert(SCALER_TEMPORAL_FEATURE_MASK == EEG_TEMPORAL_FEATURE_MASK,
+              "scaler_params.h et feature_set.h générés pour des features différentes");
+#else
+// Scaler antérieur aux masques : seul le jeu historique de 26 features lui correspond
+static_assert(EEG_TEMPORAL_FEATURE_MASK == TEMPORAL_FEATURE_MASK_ALL,
+              "masque de features réduit : régénérer scaler_params.h avec extract_scaler.py");
+#endif
 
 BITalinoEEGPreprocessor::BITalinoEEGPreprocessor()
 {
-    buffer_index = 0;
-    sample_count = 0;
+    write_index = 0;
+    samples_buffered = 0;
+    samples_since_window = 0;
+    hop_size = HOP_SIZE;
+    incremental_mode = false;
+    anchor_interval = INCREMENTAL_ANCHOR_INTERVAL;
+    windows_since_anchor = 0;
+    feature_groups = 0;
+    window_sequence = 0;
+    features_sequence = 0;
+    setInputQuantization(1.0f, 0);
 }
 
-void BITalinoEEGPreprocessor::begin()
+void BITalinoEEGPreprocessor::begin(int mains_frequency)
 {
+    if (mains_frequency == EEG_MAINS_FREQUENCY)
+    {
+        bandpass.setSections(BANDPASS_SECTIONS);
+    }
+    else
+    {
+        runtime_sections = designEEGBandpass(SAMPLE_RATE, mains_frequency);
+        bandpass.setSections(runtime_sections.section);
+    }
+    quality_monitor.setLineFrequency(mains_frequency);
+
+    reset();
+
+#ifdef ARDUINO
     Serial.println("╔══════════════════════════════════════════════════════════════╗");
     Serial.println("║  Initialisation du préprocesseur EEG BITalino...            ║");
     Serial.println("╚══════════════════════════════════════════════════════════════╝");
 
-    reset();
-
     Serial.printf("  ✓ Taux d'échantillonnage: %d Hz\n", SAMPLE_RATE);
+    if (mains_frequency > 0)
+        Serial.printf("  ✓ Réjecteur secteur: %d Hz\n", mains_frequency);
     Serial.printf("  ✓ Taille de fenêtre: %d échantillons\n", WINDOW_SIZE);
-    Serial.printf("  ✓ Recouvrement: %d%% (%d échantillons)\n",
-                  OVERLAP_PERCENTAGE, OVERLAP_SIZE);
+    Serial.printf("  ✓ Recouvrement: %d%% (%d échantillons, hop: %d)\n",
+                  (WINDOW_SIZE - hop_size) * 100 / WINDOW_SIZE,
+                  WINDOW_SIZE - hop_size, hop_size);
+#ifdef BITALINO_FIXED_POINT
+    Serial.println("  ✓ Chaîne DSP: virgule fixe (Q8 µV, biquads Q30)");
+#endif
     Serial.println("  ✓ Préprocesseur EEG BITalino initialisé");
+#endif
 }
 
 float BITalinoEEGPreprocessor::convertADCtoMicrovolts(int adc_value)
 {
-
-    float voltage = ((float)adc_value / BITALINO_ADC_RESOLUTION) * BITALINO_VCC;
-
-    float eeg_voltage = (voltage - EEG_VCC_HALF) / EEG_GAIN;
-
-    return eeg_voltage * 1e6;
+#ifdef BITALINO_FIXED_POINT
+    return fixedToMicrovolts(adcToFixed(adc_value));
+#else
+    return adcToMicrovolts(adc_value);
+#endif
 }
 
-float BITalinoEEGPreprocessor::applyHighPassFilter(float sample)
+bool BITalinoEEGPreprocessor::addSample(int adc_value)
 {
+#ifdef BITALINO_FIXED_POINT
+    eeg_fixed_t sample = adcToFixed(adc_value);
+    eeg_fixed_t filtered_q = bandpass.process(sample);
 
-    for (int i = 4; i > 0; i--)
-    {
-        hpf_x[i] = hpf_x[i - 1];
-        hpf_y[i] = hpf_y[i - 1];
-    }
+    storeFixedBlock(&filtered_q, 1);
+
+    float microvolts = fixedToMicrovolts(sample);
+    float filtered = fixedToMicrovolts(filtered_q);
+#else
+    float microvolts = convertADCtoMicrovolts(adc_value);
 
-    hpf_x[0] = sample;
+    float filtered = bandpass.process(microvolts);
+#endif
 
-    hpf_y[0] = HPF_B0 * hpf_x[0] + HPF_B1 * hpf_x[1] + HPF_B2 * hpf_x[2] +
-               HPF_B3 * hpf_x[3] + HPF_B4 * hpf_x[4] -
-               HPF_A1 * hpf_y[1] - HPF_A2 * hpf_y[2] -
-               HPF_A3 * hpf_y[3] - HPF_A4 * hpf_y[4];
+    storeQuality(&adc_value, &microvolts, 1);
+    storeSample(microvolts, filtered);
 
-    return hpf_y[0];
+    return advanceWindowCounters(1) > 0;
 }
 
-float BITalinoEEGPreprocessor::applyLowPassFilter(float sample)
+size_t BITalinoEEGPreprocessor::addSamples(const int *adc_values, size_t count)
 {
+    float microvolts[INGEST_BLOCK_SIZE];
+    float filtered[INGEST_BLOCK_SIZE];
+    size_t consumed = 0;
 
-    for (int i = 4; i > 0; i--)
+    while (consumed < count)
     {
-        lpf_x[i] = lpf_x[i - 1];
-        lpf_y[i] = lpf_y[i - 1];
-    }
+        // Jamais au-delà de la prochaine fenêtre : elle doit finir sur le hop
+        int n = std::min(samplesToNextWindow(), INGEST_BLOCK_SIZE);
+        if ((size_t)n > count - consumed)
+        {
+            n = (int)(count - consumed);
+        }
 
-    lpf_x[0] = sample;
+#ifdef BITALINO_FIXED_POINT
+        eeg_fixed_t samples_q[INGEST_BLOCK_SIZE];
+        eeg_fixed_t filtered_q[INGEST_BLOCK_SIZE];
 
-    lpf_y[0] = LPF_B0 * lpf_x[0] + LPF_B1 * lpf_x[1] + LPF_B2 * lpf_x[2] +
-               LPF_B3 * lpf_x[3] + LPF_B4 * lpf_x[4] -
-               LPF_A1 * lpf_y[1] - LPF_A2 * lpf_y[2] -
-               LPF_A3 * lpf_y[3] - LPF_A4 * lpf_y[4];
+        for (int i = 0; i < n; i++)
+        {
+            samples_q[i] = adcToFixed(adc_values[i]);
+        }
 
-    return lpf_y[0];
-}
+        bandpass.processBlock(samples_q, filtered_q, n);
+        storeFixedBlock(filtered_q, n);
 
-bool BITalinoEEGPreprocessor::addSample(int adc_value)
-{
+        for (int i = 0; i < n; i++)
+        {
+            microvolts[i] = fixedToMicrovolts(samples_q[i]);
+            filtered[i] = fixedToMicrovolts(filtered_q[i]);
+        }
+#else
+        for (int i = 0; i < n; i++)
+        {
+            microvolts[i] = convertADCtoMicrovolts(adc_values[i]);
+        }
 
-    float microvolts = convertADCtoMicrovolts(adc_value);
+        bandpass.processBlock(microvolts, filtered, n);
+#endif
 
-    float high_passed = applyHighPassFilter(microvolts);
-    float filtered = applyLowPassFilter(high_passed);
+        storeQuality(adc_values, microvolts, n);
 
-    raw_buffer[buffer_index] = microvolts;
-    filtered_buffer[buffer_index] = filtered;
+        if (incremental_mode)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                storeSample(microvolts[i], filtered[i]);
+            }
+        }
+        else
+        {
+            storeBlock(microvolts, filtered, n);
+        }
 
-    buffer_index++;
-    sample_count++;
+        adc_values += n;
+        consumed += n;
 
-    if (buffer_index >= WINDOW_SIZE)
+        if (advanceWindowCounters(n) > 0)
+        {
+            break;
+        }
+    }
+
+    return consumed;
+}
+
+int BITalinoEEGPreprocessor::samplesToNextWindow() const
+{
+    if (samples_buffered < WINDOW_SIZE)
     {
-        buffer_index = 0;
-        return true;
+        return WINDOW_SIZE - samples_buffered;
     }
 
-    return false;
+    // Hop réduit depuis la dernière fenêtre : elle est due au prochain échantillon
+    return std::max(1, hop_size - samples_since_window);
 }
 
-bool BITalinoEEGPreprocessor::extractFeatures()
+void BITalinoEEGPreprocessor::storeSample(float microvolts, float filtered)
 {
-    int feature_idx = 0;
+    float leaving = filtered_buffer[write_index];
 
-    extractTemporalFeatures(filtered_buffer, WINDOW_SIZE, feature_idx);
-    feature_idx += 26;
+    goertzel.update(filtered, leaving);
 
-    int segment_size = WINDOW_SIZE / NUM_SEGMENTS;
+    raw_buffer[write_index] = microvolts;
+    raw_buffer[write_index + WINDOW_SIZE] = microvolts;
+    filtered_buffer[write_index] = filtered;
+    filtered_buffer[write_index + WINDOW_SIZE] = filtered;
 
-    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+    if (++write_index == WINDOW_SIZE)
     {
-        int start_idx = seg * segment_size;
-        extractTemporalFeatures(&filtered_buffer[start_idx], segment_size, feature_idx);
-        feature_idx += 26;
+        write_index = 0;
     }
 
-    return true;
+    if (incremental_mode)
+    {
+        incremental.update(getWindow(), leaving);
+    }
 }
 
-void BITalinoEEGPreprocessor::extractTemporalFeatures(float *segment, int length, int feature_offset)
+void BITalinoEEGPreprocessor::storeBlock(const float *microvolts, const float *filtered, int n)
 {
-    float mean_val = calculateMean(segment, length);
-    float std_val = calculateStd(segment, length, mean_val);
-
-    features[feature_offset + 0] = mean_val;
-    features[feature_offset + 1] = calculateMedian(segment, length);
-    features[feature_offset + 2] = std_val;
-    features[feature_offset + 3] = calculateVariance(segment, length, mean_val);
-    features[feature_offset + 4] = calculateMin(segment, length);
-    features[feature_offset + 5] = calculateMax(segment, length);
-    features[feature_offset + 6] = calculateRange(segment, length);
-    features[feature_offset + 7] = calculateRMS(segment, length);
-    features[feature_offset + 8] = calculateEnergy(segment, length);
-    features[feature_offset + 9] = calculateSkewness(segment, length, mean_val, std_val);
-    features[feature_offset + 10] = calculateKurtosis(segment, length, mean_val, std_val);
-    features[feature_offset + 11] = countZeroCrossings(segment, length);
-    features[feature_offset + 12] = calculateEntropy(segment, length);
-    features[feature_offset + 13] = calculateMeanDiff(segment, length);
-    features[feature_offset + 14] = calculateStdDiff(segment, length);
-    features[feature_offset + 15] = calculatePeakToPeak(segment, length);
-
-    features[feature_offset + 16] = std_val / (mean_val + 1e-8);
-    features[feature_offset + 17] = calculateMax(segment, length) / (calculateMin(segment, length) + 1e-8);
-    features[feature_offset + 18] = std::abs(mean_val);
-    features[feature_offset + 19] = std_val * std_val;
-    features[feature_offset + 20] = calculateRMS(segment, length) / (std::abs(mean_val) + 1e-8);
-    features[feature_offset + 21] = calculateEnergy(segment, length) / length;
-    features[feature_offset + 22] = (calculateMax(segment, length) - calculateMin(segment, length)) / 2.0f;
-    features[feature_offset + 23] = std::abs(calculateMeanDiff(segment, length));
-    features[feature_offset + 24] = calculateStdDiff(segment, length) / (std_val + 1e-8);
-    features[feature_offset + 25] = countZeroCrossings(segment, length) / (float)length;
-}
+    while (n > 0)
+    {
+        int run = std::min(n, WINDOW_SIZE - write_index);
+        size_t bytes = run * sizeof(float);
 
-float *BITalinoEEGPreprocessor::getNormalizedFeatures()
-{
+        for (int i = 0; i < run; i++)
+        {
+            goertzel.update(filtered[i], filtered_buffer[write_index + i]);
+        }
 
-    if (!extractFeatures())
-    {
-        return nullptr;
-    }
+        memcpy(&raw_buffer[write_index], microvolts, bytes);
+        memcpy(&raw_buffer[write_index + WINDOW_SIZE], microvolts, bytes);
+        memcpy(&filtered_buffer[write_index], filtered, bytes);
+        memcpy(&filtered_buffer[write_index + WINDOW_SIZE], filtered, bytes);
 
-    normalizeFeatures();
+        write_index += run;
+        if (write_index == WINDOW_SIZE)
+        {
+            write_index = 0;
+        }
 
-    return normalized_features;
+        microvolts += run;
+        filtered += run;
+        n -= run;
+    }
 }
 
-void BITalinoEEGPreprocessor::normalizeFeatures()
+#ifdef BITALINO_FIXED_POINT
+// Écrit à partir de write_index sans l'avancer : doit précéder storeSample/storeBlock
+void BITalinoEEGPreprocessor::storeFixedBlock(const eeg_fixed_t *filtered, int n)
 {
-    for (int i = 0; i < 194; i++)
+    int index = write_index;
+
+    while (n > 0)
     {
-        normalized_features[i] = (features[i] - scaler_mean[i]) / scaler_scale[i];
+        int run = std::min(n, WINDOW_SIZE - index);
+        size_t bytes = run * sizeof(eeg_fixed_t);
+
+        memcpy(&filtered_fixed[index], filtered, bytes);
+        memcpy(&filtered_fixed[index + WINDOW_SIZE], filtered, bytes);
+
+        index += run;
+        if (index == WINDOW_SIZE)
+        {
+            index = 0;
+        }
+
+        filtered += run;
+        n -= run;
     }
 }
+#endif
 
-float BITalinoEEGPreprocessor::calculateMean(float *data, int length)
+// Lit les échantillons bruts sortants : doit précéder storeSample/storeBlock
+void BITalinoEEGPreprocessor::storeQuality(const int *adc_values, const float *microvolts, int n)
 {
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    int index = write_index;
+
+    for (int i = 0; i < n; i++)
     {
-        sum += data[i];
+        quality_monitor.update(index, adc_values[i], microvolts[i], raw_buffer[index]);
+
+        if (++index == WINDOW_SIZE)
+        {
+            index = 0;
+        }
     }
-    return sum / length;
 }
 
-float BITalinoEEGPreprocessor::calculateMedian(float *data, int length)
+int BITalinoEEGPreprocessor::advanceWindowCounters(int n)
 {
-    float temp[WINDOW_SIZE];
-    memcpy(temp, data, length * sizeof(float));
-    std::sort(temp, temp + length);
+    int windows = 0;
 
-    if (length % 2 == 0)
+    if (samples_buffered < WINDOW_SIZE)
     {
-        return (temp[length / 2 - 1] + temp[length / 2]) / 2.0f;
-    }
-    else
-    {
-        return temp[length / 2];
+        int fill = std::min(n, WINDOW_SIZE - samples_buffered);
+        samples_buffered += fill;
+        samples_since_window += fill;
+        n -= fill;
+
+        if (samples_buffered < WINDOW_SIZE)
+        {
+            return 0;
+        }
+
+        // Première fenêtre complète : samples_since_window >= WINDOW_SIZE >= hop
+        windows = 1;
+        samples_since_window = 0;
     }
+
+    samples_since_window += n;
+    windows += samples_since_window / hop_size;
+    samples_since_window %= hop_size;
+
+    window_sequence += windows;
+
+    return windows;
 }
 
-float BITalinoEEGPreprocessor::calculateStd(float *data, int length, float mean)
+void BITalinoEEGPreprocessor::setIncrementalMode(bool enabled, int new_anchor_interval)
 {
-    return std::sqrt(calculateVariance(data, length, mean));
+    // Le moteur incrémental suppose des segments de SEGMENT_SIZE échantillons
+    // et ne glisse ni les différences secondes ni le Teager–Kaiser
+    incremental_mode = enabled && EEGWindowGeometry::RemainderPolicy == SEGMENT_REMAINDER_DROP &&
+                       !(EEGTemporalFeatureSet::Stats & (STAT_DIFF2_SQ | STAT_TKEO));
+    anchor_interval = std::max(1, new_anchor_interval);
+    windows_since_anchor = 0;
+    incremental.reset();
+    features_sequence = 0;
 }
 
-float BITalinoEEGPreprocessor::calculateVariance(float *data, int length, float mean)
+void BITalinoEEGPreprocessor::setOverlapPercentage(int overlap_percentage)
 {
-    float sum = 0;
-    for (int i = 0; i < length; i++)
-    {
-        float diff = data[i] - mean;
-        sum += diff * diff;
-    }
-    return sum / length;
+    overlap_percentage = std::max(0, std::min(overlap_percentage, 99));
+    setHopSize(WINDOW_SIZE - WINDOW_SIZE * overlap_percentage / 100);
 }
 
-float BITalinoEEGPreprocessor::calculateMin(float *data, int length)
+void BITalinoEEGPreprocessor::setHopSize(int new_hop_size)
 {
-    float min_val = data[0];
-    for (int i = 1; i < length; i++)
-    {
-        if (data[i] < min_val)
-            min_val = data[i];
-    }
-    return min_val;
+    hop_size = std::max(1, std::min(new_hop_size, WINDOW_SIZE));
 }
 
-float BITalinoEEGPreprocessor::calculateMax(float *data, int length)
+void BITalinoEEGPreprocessor::setFeatureGroups(unsigned groups)
 {
-    float max_val = data[0];
-    for (int i = 1; i < length; i++)
+    groups &= FEATURE_GROUPS_ALL;
+
+    if (groups != feature_groups)
     {
-        if (data[i] > max_val)
-            max_val = data[i];
+        feature_groups = groups;
+        features_sequence = 0;
     }
-    return max_val;
 }
 
-float BITalinoEEGPreprocessor::calculateRange(float *data, int length)
+bool BITalinoEEGPreprocessor::extractFeatures()
 {
-    return calculateMax(data, length) - calculateMin(data, length);
-}
+    if (window_sequence == 0)
+    {
+        return false;
+    }
+    if (features_sequence == window_sequence)
+    {
+        return true;
+    }
 
-float BITalinoEEGPreprocessor::calculateRMS(float *data, int length)
-{
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    int feature_idx = 0;
+    const float *window = getWindow();
+    SegmentStats window_stats;
+
+    if (incremental_mode)
     {
-        sum += data[i] * data[i];
+        if (!incremental.isAnchored() || ++windows_since_anchor >= anchor_interval)
+        {
+            incremental.anchor(window);
+            windows_since_anchor = 0;
+        }
+
+        SegmentStats stats;
+        incremental.getWindowStats(window_stats);
+        EEGTemporalFeatureSet::write(window_stats, &features[feature_idx]);
+        feature_idx += EEGTemporalFeatureSet::NumFeatures;
+
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+        {
+            incremental.getSegmentStats(seg, stats);
+            EEGTemporalFeatureSet::write(stats, &features[feature_idx]);
+            feature_idx += EEGTemporalFeatureSet::NumFeatures;
+        }
+    }
+    else
+    {
+        extractWindowFeatures(window_stats);
+        feature_idx += NUM_TEMPORAL_LAYOUT_FEATURES;
     }
-    return std::sqrt(sum / length);
-}
 
-float BITalinoEEGPreprocessor::calculateEnergy(float *data, int length)
-{
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    // Puissance du signal filtré : variance de la passe des features si le
+    // masque la calcule, sinon énergie (moyenne ~0 après le passe-haut)
+    float signal_power;
+    if (EEGTemporalFeatureSet::Stats & STAT_M2)
     {
-        sum += data[i] * data[i];
+        signal_power = window_stats.m2 / WINDOW_SIZE;
+    }
+    else
+    {
+        signal_power = dspDotProduct(window, window, WINDOW_SIZE) / WINDOW_SIZE;
+    }
+    quality_monitor.evaluate(signal_power, quality);
+    if (incremental_mode)
+    {
+        computeWindowActivity<EEGTemporalFeatureSet::Stats>(window_stats, window, activity);
+    }
+    else
+    {
+        computeWindowActivity<EEGWindowFeatureKernel::Stats>(window_stats, window, activity);
     }
-    return sum;
-}
 
-float BITalinoEEGPreprocessor::calculateSkewness(float *data, int length, float mean, float std)
-{
-    if (std < 1e-8)
-        return 0.0f;
+    if (feature_groups & FEATURE_GROUP_SPECTRAL)
+    {
+        computeSpectralFeatures(window, &features[feature_idx]);
+        feature_idx += NUM_SPECTRAL_FEATURES;
+    }
 
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    if (feature_groups & FEATURE_GROUP_WAVELET)
     {
-        float z = (data[i] - mean) / std;
-        sum += z * z * z;
+        computeWaveletFeatures(window, &features[feature_idx]);
+        feature_idx += NUM_WAVELET_FEATURES;
     }
-    return sum / length;
+
+    if (feature_groups & FEATURE_GROUP_COMPLEXITY)
+    {
+        computeComplexityFeatures(window, &features[feature_idx]);
+    }
+
+    features_sequence = window_sequence;
+
+    return true;
 }
 
-float BITalinoEEGPreprocessor::calculateKurtosis(float *data, int length, float mean, float std)
+void BITalinoEEGPreprocessor::extractWindowFeatures(SegmentStats &window_stats)
 {
-    if (std < 1e-8)
-        return 0.0f;
+    int feature_idx = 0;
+
+#ifdef BITALINO_FIXED_POINT
+    const eeg_fixed_t *window_fixed = &filtered_fixed[write_index];
+
+    extractTemporalFeatures(window_fixed, WINDOW_SIZE, feature_idx, window_stats);
+    feature_idx += EEGTemporalFeatureSet::NumFeatures;
 
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
     {
-        float z = (data[i] - mean) / std;
-        sum += z * z * z * z;
+        SegmentStats stats;
+        extractTemporalFeatures(&window_fixed[EEGWindowGeometry::segmentStart(seg)],
+                                EEGWindowGeometry::segmentLength(seg), feature_idx, stats);
+        feature_idx += EEGTemporalFeatureSet::NumFeatures;
     }
-    return (sum / length) - 3.0f;
+#else
+    // Segments parcourus une fois, fenêtre par fusion de leurs statistiques
+    EEGWindowFeatureKernel::computeWindow(getWindow(), &features[feature_idx], &window_stats);
+#endif
 }
 
-int BITalinoEEGPreprocessor::countZeroCrossings(float *data, int length)
+#ifdef BITALINO_FIXED_POINT
+void BITalinoEEGPreprocessor::extractTemporalFeatures(const eeg_fixed_t *segment, int length, int feature_offset,
+                                                      SegmentStats &stats)
 {
-    int count = 0;
-    for (int i = 1; i < length; i++)
-    {
-        if ((data[i - 1] >= 0 && data[i] < 0) || (data[i - 1] < 0 && data[i] >= 0))
-        {
-            count++;
-        }
-    }
-    return count;
+    FixedSegmentStats fixed;
+    computeFixedSegmentStats(segment, length, fixed);
+    fixedToSegmentStats(fixed, stats);
+    EEGTemporalFeatureSet::write(stats, &features[feature_offset]);
 }
+#endif
 
-float BITalinoEEGPreprocessor::calculateEntropy(float *data, int length)
+bool BITalinoEEGPreprocessor::normalizeFeatures(float *out, int capacity)
 {
+    if (!extractFeatures())
+    {
+        return false;
+    }
+
+    // Le vecteur produit peut dépasser le tenseur d'entrée (layout temporal :
+    // 8 blocs de features, scaler et modèle sur un préfixe)
+    int count = std::min(getFeatureCount(), capacity);
+
+#ifdef EEG_SCALER_FOLDED
+    // Scaler intégré à la première couche Dense (docs/fold_scaler.py) : le
+    // modèle consomme les features brutes
+    memcpy(out, features, count * sizeof(float));
+#else
+    int scaled = std::min(count, NUM_FEATURES);
+
+    for (int i = 0; i < scaled; i++)
+    {
+        out[i] = (features[i] - scaler_mean[i]) / scaler_scale[i];
+    }
 
-    float sum = 0;
-    for (int i = 0; i < length; i++)
+    // Features hors du scaler courant : transmises telles quelles
+    for (int i = scaled; i < count; i++)
     {
-        float p = std::abs(data[i]) + 1e-8;
-        sum += p * std::log(p);
+        out[i] = features[i];
     }
-    return -sum;
+#endif
+
+    return true;
 }
 
-float BITalinoEEGPreprocessor::calculateMeanDiff(float *data, int length)
+void BITalinoEEGPreprocessor::setInputQuantization(float input_scale, int input_zero_point)
 {
-    float sum = 0;
-    for (int i = 1; i < length; i++)
+    for (int i = 0; i < NUM_FEATURES; i++)
     {
-        sum += std::abs(data[i] - data[i - 1]);
+#ifdef EEG_SCALER_FOLDED
+        // q = f / s + zp (features brutes)
+        quant_gain[i] = 1.0f / input_scale;
+        quant_offset[i] = input_zero_point;
+#else
+        // q = (f − mean) / (scale · s) + zp = f · gain + offset
+        quant_gain[i] = 1.0f / (scaler_scale[i] * input_scale);
+        quant_offset[i] = input_zero_point - scaler_mean[i] * quant_gain[i];
+#endif
     }
-    return sum / (length - 1);
 }
 
-float BITalinoEEGPreprocessor::calculateStdDiff(float *data, int length)
+bool BITalinoEEGPreprocessor::quantizeFeatures(int8_t *out)
 {
-    float mean_diff = calculateMeanDiff(data, length);
-    float sum = 0;
-
-    for (int i = 1; i < length; i++)
+    if (!extractFeatures())
     {
-        float diff = std::abs(data[i] - data[i - 1]) - mean_diff;
-        sum += diff * diff;
+        return false;
     }
 
-    return std::sqrt(sum / (length - 1));
-}
+    for (int i = 0; i < NUM_FEATURES; i++)
+    {
+        float q = features[i] * quant_gain[i] + quant_offset[i];
+        q = std::max(-128.0f, std::min(q, 127.0f));
+        // Arrondi au plus proche, moitiés loin de zéro (comme l'op Quantize TFLite)
+        out[i] = (int8_t)(q + std::copysign(0.5f, q));
+    }
 
-float BITalinoEEGPreprocessor::calculatePeakToPeak(float *data, int length)
-{
-    return calculateMax(data, length) - calculateMin(data, length);
+    return true;
 }
 
 void BITalinoEEGPreprocessor::reset()
 {
-    buffer_index = 0;
-    sample_count = 0;
+    write_index = 0;
+    samples_buffered = 0;
+    samples_since_window = 0;
+    windows_since_anchor = 0;
+    window_sequence = 0;
+    features_sequence = 0;
+    incremental.reset();
+    goertzel.reset();
+    quality_monitor.reset();
+    memset(&quality, 0, sizeof(quality));
+    memset(&activity, 0, sizeof(activity));
 
     memset(raw_buffer, 0, sizeof(raw_buffer));
     memset(filtered_buffer, 0, sizeof(filtered_buffer));
+#ifdef BITALINO_FIXED_POINT
+    memset(filtered_fixed, 0, sizeof(filtered_fixed));
+#endif
     memset(features, 0, sizeof(features));
-    memset(normalized_features, 0, sizeof(normalized_features));
 
-    memset(hpf_x, 0, sizeof(hpf_x));
-    memset(hpf_y, 0, sizeof(hpf_y));
-    memset(lpf_x, 0, sizeof(lpf_x));
-    memset(lpf_y, 0, sizeof(lpf_y));
+    bandpass.reset();
 }
\ No newline at end of file
@@ -2,41 +2,81 @@
  * @file BITalinoEEG_Preprocessor.h
  * @brief Prétraitement des signaux EEG BITalino pour détection d'épilepsie
  *
+ * Pipeline par étapes :
+ *  1. ingestion : addSample() / addSamples() ;
+ *  2. fenêtre prête : getWindowSequence() augmente à chaque fenêtre complète ;
+ *  3. features : extractFeatures(), calculées une seule fois par fenêtre ;
+ *  4. sortie : normalizeFeatures() (float) ou quantizeFeatures() (int8),
+ *     écrites dans un tampon de l'appelant (tenseur d'entrée TFLite).
+ * Les étapes 3 et 4 déclenchent les précédentes si besoin : les appels
+ * répétés pour une même fenêtre ne recalculent rien.
  */
 
 #ifndef BITALINO_EEG_PREPROCESSOR_H
 #define BITALINO_EEG_PREPROCESSOR_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+#include <cstring>
+#endif
 
-#define SAMPLE_RATE 178
-#define WINDOW_SIZE 178
-#define OVERLAP_PERCENTAGE 50
-#define NUM_SEGMENTS 7
-
-#define HPF_B0 0.9895f
-#define HPF_B1 -3.9580f
-#define HPF_B2 5.9370f
-#define HPF_B3 -3.9580f
-#define HPF_B4 0.9895f
-
-#define HPF_A0 1.0000f
-#define HPF_A1 -3.9580f
-#define HPF_A2 5.9162f
-#define HPF_A3 -3.9370f
-#define HPF_A4 0.9790f
-
-#define LPF_B0 0.0201f
-#define LPF_B1 0.0804f
-#define LPF_B2 0.1206f
-#define LPF_B3 0.0804f
-#define LPF_B4 0.0201f
-
-#define LPF_A0 1.0000f
-#define LPF_A1 -1.9644f
-#define LPF_A2 1.7469f
-#define LPF_A3 -0.7498f
-#define LPF_A4 0.1327f
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_FeatureSet.h"
+#include "BITalinoEEG_Filters.h"
+#include "BITalinoEEG_Fixed.h"
+#include "BITalinoEEG_Incremental.h"
+#include "BITalinoEEG_Spectral.h"
+#include "BITalinoEEG_Goertzel.h"
+#include "BITalinoEEG_Wavelet.h"
+#include "BITalinoEEG_Complexity.h"
+#include "BITalinoEEG_Quality.h"
+#include "BITalinoEEG_Cascade.h"
+#include "BITalinoEEG_FilterDesign.h"
+
+// Vecteur de features : features temporelles de la fenêtre puis des 7
+// segments (8 × 26, ou 8 × EEGTemporalFeatureSet::NumFeatures avec un masque
+// réduit), suivies des groupes sélectionnés, indépendants, dans cet ordre :
+#define FEATURE_GROUP_SPECTRAL 0x01   // NUM_SPECTRAL_FEATURES (FFT)
+#define FEATURE_GROUP_WAVELET 0x02    // NUM_WAVELET_FEATURES (DWT)
+#define FEATURE_GROUP_COMPLEXITY 0x04 // NUM_COMPLEXITY_FEATURES
+#define FEATURE_GROUPS_ALL (FEATURE_GROUP_SPECTRAL | FEATURE_GROUP_WAVELET | FEATURE_GROUP_COMPLEXITY)
+
+// Versions historiques du vecteur (groupes emboîtés), voir featureLayoutGroups()
+#define FEATURE_LAYOUT_TEMPORAL 1
+#define FEATURE_LAYOUT_SPECTRAL 2
+#define FEATURE_LAYOUT_WAVELET 3
+#define FEATURE_LAYOUT_COMPLEXITY 4
+#define NUM_TEMPORAL_LAYOUT_FEATURES (EEGTemporalFeatureSet::NumFeatures * (1 + NUM_SEGMENTS))
+#define MAX_FEATURES \
+    (NUM_TEMPORAL_LAYOUT_FEATURES + NUM_SPECTRAL_FEATURES + NUM_WAVELET_FEATURES + NUM_COMPLEXITY_FEATURES)
+
+/**
+ * @brief Groupes d'une version historique (1 : aucun, 2 : spectral,
+ *        3 : + ondelettes, 4 : + complexité ; inconnue : aucun)
+ */
+constexpr unsigned featureLayoutGroups(int layout)
+{
+    return layout == FEATURE_LAYOUT_SPECTRAL    ? FEATURE_GROUP_SPECTRAL
+           : layout == FEATURE_LAYOUT_WAVELET    ? FEATURE_GROUP_SPECTRAL | FEATURE_GROUP_WAVELET
+           : layout == FEATURE_LAYOUT_COMPLEXITY ? FEATURE_GROUPS_ALL
+                                                 : 0u;
+}
+
+/**
+ * @brief Taille du vecteur (par voie) pour une combinaison de groupes
+ */
+constexpr int featureGroupsCount(unsigned groups)
+{
+    return NUM_TEMPORAL_LAYOUT_FEATURES + ((groups & FEATURE_GROUP_SPECTRAL) ? NUM_SPECTRAL_FEATURES : 0) +
+           ((groups & FEATURE_GROUP_WAVELET) ? NUM_WAVELET_FEATURES : 0) +
+           ((groups & FEATURE_GROUP_COMPLEXITY) ? NUM_COMPLEXITY_FEATURES : 0);
+}
+
+// Passe des features de la fenêtre : mêmes features que EEGTemporalFeatureSet,
+// plus les mesures du pré-détecteur (Teager–Kaiser sans passe séparée)
+typedef TemporalFeatureSet<EEG_TEMPORAL_FEATURE_MASK, EEGWindowGeometry, CASCADE_WINDOW_STATS> EEGWindowFeatureKernel;
 
 class BITalinoEEGPreprocessor
 {
@@ -48,8 +88,11 @@ public:
 
     /**
      * @brief Initialiser le préprocesseur
+     * @param mains_frequency Fréquence secteur (50 / 60 Hz, 0 : pas de
+     *        réjecteur). Différente de EEG_MAINS_FREQUENCY, le passe-bande
+     *        est recalculé ici au lieu d'utiliser la table compilée.
      */
-    void begin();
+    void begin(int mains_frequency = EEG_MAINS_FREQUENCY);
 
     /**
      * @brief Convertir une valeur ADC en microvolts
@@ -66,57 +109,215 @@ public:
     bool addSample(int adc_value);
 
     /**
-     * @brief Extraire les features de la fenêtre courante
-     * @return true si l'extraction a réussi
+     * @brief Ajouter un bloc d'échantillons (conversion et filtrage par blocs)
+     * @param adc_values Valeurs ADC (0-1023)
+     * @param count Nombre d'échantillons
+     * @return Nombre d'échantillons consommés : l'ingestion s'arrête juste
+     *         après la première fenêtre complétée (getWindowSequence() a
+     *         alors avancé) ; rappeler avec le reste du bloc
+     */
+    size_t addSamples(const int *adc_values, size_t count);
+
+    /**
+     * @brief Signaler des trames perdues (saut du numéro de séquence BITalino)
+     *        avant le prochain échantillon
+     */
+    void markSampleGap() { quality_monitor.markGap(); }
+
+    /**
+     * @brief Configurer le recouvrement entre fenêtres successives
+     * @param overlap_percentage Recouvrement en % (0-99), ex: 25, 50, 75
+     */
+    void setOverlapPercentage(int overlap_percentage);
+
+    /**
+     * @brief Configurer le pas (hop) entre deux fenêtres
+     * @param hop_size Nombre de nouveaux échantillons par décision (1-WINDOW_SIZE)
+     */
+    void setHopSize(int hop_size);
+
+    int getHopSize() const { return hop_size; }
+
+    /**
+     * @brief Activer le mode de features incrémental (O(hop) par décision)
+     * @param enabled true pour mettre à jour les statistiques à chaque échantillon
+     *        (sans effet si EEG_SEGMENT_REMAINDER n'est pas SEGMENT_REMAINDER_DROP :
+     *        les segments incrémentaux ont tous SEGMENT_SIZE échantillons, ni
+     *        si le masque retient hjorth_complexity ou tkeo)
+     * @param anchor_interval Nombre de fenêtres entre deux recalculs exacts
+     */
+    void setIncrementalMode(bool enabled, int anchor_interval = INCREMENTAL_ANCHOR_INTERVAL);
+
+    /**
+     * @brief Choisir les groupes ajoutés aux features temporelles ; seuls les
+     *        étages des groupes retenus (FFT, DWT, complexité) sont calculés
+     * @param groups Combinaison de FEATURE_GROUP_* (0 : temporel seul)
+     */
+    void setFeatureGroups(unsigned groups);
+
+    unsigned getFeatureGroups() const { return feature_groups; }
+
+    /**
+     * @brief Choisir une version historique du vecteur de features
+     * @param layout FEATURE_LAYOUT_TEMPORAL, FEATURE_LAYOUT_SPECTRAL,
+     *        FEATURE_LAYOUT_WAVELET ou FEATURE_LAYOUT_COMPLEXITY
+     */
+    void setFeatureLayout(int layout) { setFeatureGroups(featureLayoutGroups(layout)); }
+
+    /**
+     * @brief Nombre de features produites par extractFeatures() pour les groupes courants
+     */
+    int getFeatureCount() const { return featureGroupsCount(feature_groups); }
+
+    /**
+     * @brief Features brutes (non normalisées) de la dernière extraction
+     */
+    const float *getFeatures() const { return features; }
+
+    /**
+     * @brief Banc de Goertzel mis à jour à chaque échantillon filtré
+     *
+     * Les magnitudes portent sur la fenêtre courante (getWindow()).
+     */
+    const EEGGoertzelBank &getGoertzelBank() const { return goertzel; }
+
+    /**
+     * @brief Fenêtre filtrée courante, lue en place dans le buffer circulaire
+     * @return Pointeur vers WINDOW_SIZE échantillons contigus (du plus ancien au plus récent)
+     */
+    const float *getWindow() const { return &filtered_buffer[write_index]; }
+
+    /**
+     * @brief Fenêtre brute (µV) courante, lue en place dans le buffer circulaire
+     */
+    const float *getRawWindow() const { return &raw_buffer[write_index]; }
+
+    /**
+     * @brief Numéro de la dernière fenêtre complète (0 : aucune depuis reset())
+     */
+    uint32_t getWindowSequence() const { return window_sequence; }
+
+    /**
+     * @brief true si getFeatures() correspond à la dernière fenêtre complète
+     */
+    bool hasFeatures() const { return window_sequence != 0 && features_sequence == window_sequence; }
+
+    /**
+     * @brief Extraire les features de la dernière fenêtre complète
+     *
+     * Sans effet si elles sont déjà en cache pour ce numéro de fenêtre
+     * (changer de groupes ou de mode invalide le cache). Le calcul porte sur
+     * la fenêtre courante au premier appel.
+     * @return false tant qu'aucune fenêtre n'est complète
      */
     bool extractFeatures();
 
     /**
-     * @brief Obtenir les features normalisées
-     * @return Pointeur vers le tableau de features (194 éléments)
+     * @brief Qualité de la fenêtre des features courantes (mise à jour par extractFeatures())
+     *
+     * usable == false : fenêtre à ne pas soumettre au modèle (saturation,
+     * ligne plate, secteur ou trames perdues, voir BITalinoEEG_Quality.h).
+     */
+    const SignalQuality &getSignalQuality() const { return quality; }
+
+    /**
+     * @brief Longueur de ligne, énergie et Teager–Kaiser de la fenêtre des
+     *        features courantes, pour le pré-détecteur (CascadeGate)
+     */
+    const WindowActivity &getWindowActivity() const { return activity; }
+
+    /**
+     * @brief Écrire les features normalisées (StandardScaler) dans un tampon externe
+     * @param out Tampon de sortie, par ex. input->data.f d'un modèle à entrée
+     *        float ; seules les NUM_FEATURES premières sont normalisées.
+     *        Avec -DEEG_SCALER_FOLDED (scaler intégré au modèle), simple copie
+     *        des features brutes.
+     * @param capacity Taille de out : min(getFeatureCount(), capacity) valeurs
+     *        écrites (NUM_FEATURES pour le tenseur d'entrée du modèle)
+     * @return false tant qu'aucune fenêtre n'est complète (out non modifié)
+     */
+    bool normalizeFeatures(float *out, int capacity);
+
+    /**
+     * @brief Paramètres de quantification du tenseur d'entrée int8 du modèle
+     *
+     * Le StandardScaler et la quantification sont fusionnés en un seul
+     * q = f·gain + offset par feature, précalculé ici.
+     * @param input_scale input->params.scale
+     * @param input_zero_point input->params.zero_point
+     */
+    void setInputQuantization(float input_scale, int input_zero_point);
+
+    /**
+     * @brief Écrire les NUM_FEATURES features normalisées et quantifiées
+     * @param out Tampon du tenseur d'entrée (input->data.int8)
+     * @return false tant qu'aucune fenêtre n'est complète (out non modifié)
      */
-    float *getNormalizedFeatures();
+    bool quantizeFeatures(int8_t *out);
 
     /**
      * @brief Réinitialiser le préprocesseur
      */
     void reset();
-    void normalizeFeatures();
 
 private:
-    float raw_buffer[WINDOW_SIZE];
-    float filtered_buffer[WINDOW_SIZE];
-    float features[194];
-    float normalized_features[194];
-
-    float hpf_x[5];
-    float hpf_y[5];
-    float lpf_x[5];
-    float lpf_y[5];
-
-    int buffer_index;
-    int sample_count;
-
-    float applyHighPassFilter(float input);
-    float applyLowPassFilter(float input);
-
-    void extractTemporalFeatures(float *segment, int length, int feature_offset);
-    float calculateMean(float *data, int length);
-    float calculateMedian(float *data, int length);
-    float calculateStd(float *data, int length, float mean);
-    float calculateVariance(float *data, int length, float mean);
-    float calculateMin(float *data, int length);
-    float calculateMax(float *data, int length);
-    float calculateRange(float *data, int length);
-    float calculateRMS(float *data, int length);
-    float calculateEnergy(float *data, int length);
-    float calculateSkewness(float *data, int length, float mean, float std);
-    float calculateKurtosis(float *data, int length, float mean, float std);
-    int countZeroCrossings(float *data, int length);
-    float calculateEntropy(float *data, int length);
-    float calculateMeanDiff(float *data, int length);
-    float calculateStdDiff(float *data, int length);
-    float calculatePeakToPeak(float *data, int length);
+    // Buffers circulaires miroirs : chaque échantillon est écrit à write_index
+    // et à write_index + WINDOW_SIZE, la fenêtre courante est donc toujours
+    // contiguë à partir de write_index (pas de memmove à chaque hop).
+    float raw_buffer[2 * WINDOW_SIZE];
+    float filtered_buffer[2 * WINDOW_SIZE];
+    float features[MAX_FEATURES];
+    unsigned feature_groups;
+
+    // Scaler + quantification int8 fusionnés (voir setInputQuantization)
+    float quant_gain[MAX_FEATURES];
+    float quant_offset[MAX_FEATURES];
+
+#ifdef BITALINO_FIXED_POINT
+    // Chaîne entière : le filtrage et les statistiques batch travaillent sur
+    // filtered_fixed ; les buffers float en sont la copie convertie (fenêtres
+    // exposées et mode incrémental).
+    eeg_fixed_t filtered_fixed[2 * WINDOW_SIZE];
+    FixedBiquadCascade<BANDPASS_NUM_SECTIONS> bandpass;
+#else
+    BiquadCascade<BANDPASS_NUM_SECTIONS> bandpass;
+#endif
+    // Passe-bande calculé par begin() hors fréquence secteur du build
+    BiquadSectionSet<BANDPASS_NUM_SECTIONS> runtime_sections;
+
+    int write_index;
+    int samples_buffered;
+    int samples_since_window;
+    int hop_size;
+
+    // Cache des features : numéro de la fenêtre dont elles sont issues
+    uint32_t window_sequence;
+    uint32_t features_sequence;
+
+    EEGGoertzelBank goertzel;
+
+    SignalQualityMonitor quality_monitor;
+    SignalQuality quality;
+    WindowActivity activity;
+
+    IncrementalFeatureEngine incremental;
+    bool incremental_mode;
+    int anchor_interval;
+    int windows_since_anchor;
+
+    void storeQuality(const int *adc_values, const float *microvolts, int n);
+    void storeSample(float microvolts, float filtered);
+    void storeBlock(const float *microvolts, const float *filtered, int n);
+#ifdef BITALINO_FIXED_POINT
+    void storeFixedBlock(const eeg_fixed_t *filtered, int n);
+#endif
+    int samplesToNextWindow() const;
+    int advanceWindowCounters(int n);
+
+    void extractWindowFeatures(SegmentStats &window_stats);
+#ifdef BITALINO_FIXED_POINT
+    void extractTemporalFeatures(const eeg_fixed_t *segment, int length, int feature_offset, SegmentStats &stats);
+#endif
 };
 
 #endif
\ No newline at end of file
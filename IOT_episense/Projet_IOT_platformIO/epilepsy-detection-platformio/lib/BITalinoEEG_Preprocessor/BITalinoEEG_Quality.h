@@ -0,0 +1,181 @@
+/**
+ * @file BITalinoEEG_Quality.h
+ * @brief Indice de qualité du signal (SQI) par fenêtre
+ *
+ * Quatre indicateurs, tenus à jour à l'ingestion en O(1) par échantillon :
+ *  - saturation : fraction d'échantillons ADC à 0 ou 1023 (électrode décollée) ;
+ *  - ligne plate : fraction d'échantillons appartenant à une suite d'au moins
+ *    SQI_FLATLINE_RUN valeurs ADC identiques ;
+ *  - secteur : puissance à 50 ou 60 Hz (setLineFrequency) du signal brut
+ *    (DFT glissant, le passe-bande et le réjecteur l'atténuent) rapportée à
+ *    cette puissance plus la puissance du signal filtré, fournie par la passe
+ *    des features ;
+ *  - trous : pertes de trames signalées par markGap() (numéros de séquence
+ *    BITalino), comptées tant que l'échantillon suivant est dans la fenêtre.
+ * Les drapeaux par échantillon sont rangés dans un anneau de WINDOW_SIZE
+ * octets indexé comme les buffers du préprocesseur : chaque compteur ajoute
+ * l'échantillon entrant et retire le sortant.
+ */
+
+#ifndef BITALINO_EEG_QUALITY_H
+#define BITALINO_EEG_QUALITY_H
+
+#include <stdint.h>
+#include <cstring>
+#include <algorithm>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_Goertzel.h"
+
+#define SQI_ADC_MAX 1023
+#define SQI_FLATLINE_RUN 8
+
+// Seuils au-delà desquels la fenêtre n'est pas soumise au modèle
+#define SQI_MAX_SATURATION 0.05f
+#define SQI_MAX_FLATLINE 0.25f
+#define SQI_MAX_LINE_NOISE 0.5f
+#define SQI_MAX_GAPS 0
+
+#define SQI_FLAG_SATURATED 0x01
+#define SQI_FLAG_FLAT 0x02
+#define SQI_FLAG_GAP 0x04
+
+/**
+ * @brief Qualité d'une fenêtre
+ */
+struct SignalQuality
+{
+    float saturation;
+    float flatline;
+    float line_noise;
+    int gaps;
+
+    /** 0 (inutilisable) à 1 : 1 − pire indicateur rapporté à son seuil */
+    float score;
+    bool usable;
+};
+
+class SignalQualityMonitor
+{
+public:
+    SignalQualityMonitor()
+    {
+        setLineFrequency(EEG_MAINS_FREQUENCY);
+        reset();
+    }
+
+    /**
+     * @brief Fréquence secteur surveillée : 60 Hz, sinon 50 Hz
+     */
+    void setLineFrequency(int hz)
+    {
+        line_bin = hz == 60 ? 1 : 0;
+    }
+
+    void reset()
+    {
+        memset(flags, 0, sizeof(flags));
+        saturated_count = 0;
+        flat_count = 0;
+        gap_count = 0;
+        last_adc = -1;
+        run_length = 0;
+        pending_gap = false;
+        line.reset();
+    }
+
+    /**
+     * @brief Signaler des trames perdues avant le prochain échantillon
+     */
+    void markGap()
+    {
+        pending_gap = true;
+    }
+
+    /**
+     * @brief Intégrer un échantillon
+     * @param index Position dans l'anneau (write_index du préprocesseur)
+     * @param adc_value Valeur ADC (0-1023)
+     * @param microvolts Échantillon brut entrant (µV)
+     * @param leaving_microvolts Échantillon brut sortant de la fenêtre (µV)
+     */
+    void update(int index, int adc_value, float microvolts, float leaving_microvolts)
+    {
+        uint8_t old_flags = flags[index];
+        saturated_count -= old_flags & SQI_FLAG_SATURATED ? 1 : 0;
+        flat_count -= old_flags & SQI_FLAG_FLAT ? 1 : 0;
+        gap_count -= old_flags & SQI_FLAG_GAP ? 1 : 0;
+
+        run_length = adc_value == last_adc ? run_length + 1 : 1;
+        last_adc = adc_value;
+
+        uint8_t new_flags = 0;
+        if (adc_value <= 0 || adc_value >= SQI_ADC_MAX)
+            new_flags |= SQI_FLAG_SATURATED;
+        if (run_length >= SQI_FLATLINE_RUN)
+        {
+            new_flags |= SQI_FLAG_FLAT;
+        }
+        if (run_length == SQI_FLATLINE_RUN)
+        {
+            // La suite n'est reconnue qu'à son SQI_FLATLINE_RUN-ième échantillon :
+            // marquer les précédents, encore dans la fenêtre
+            for (int k = 1; k < SQI_FLATLINE_RUN; k++)
+            {
+                flags[(index - k + WINDOW_SIZE) % WINDOW_SIZE] |= SQI_FLAG_FLAT;
+            }
+            flat_count += SQI_FLATLINE_RUN - 1;
+        }
+        if (pending_gap)
+        {
+            new_flags |= SQI_FLAG_GAP;
+            pending_gap = false;
+        }
+
+        flags[index] = new_flags;
+        saturated_count += new_flags & SQI_FLAG_SATURATED ? 1 : 0;
+        flat_count += new_flags & SQI_FLAG_FLAT ? 1 : 0;
+        gap_count += new_flags & SQI_FLAG_GAP ? 1 : 0;
+
+        line.update(microvolts, leaving_microvolts);
+    }
+
+    /**
+     * @brief Évaluer la fenêtre courante
+     * @param signal_power Puissance moyenne du signal filtré (µV²), passe des features
+     */
+    void evaluate(float signal_power, SignalQuality &quality) const
+    {
+        float line_power = line.power(line_bin);
+
+        quality.saturation = (float)saturated_count / WINDOW_SIZE;
+        quality.flatline = (float)flat_count / WINDOW_SIZE;
+        quality.line_noise = line_power / (line_power + signal_power + 1e-12f);
+        quality.gaps = gap_count;
+
+        quality.usable = quality.saturation <= SQI_MAX_SATURATION &&
+                         quality.flatline <= SQI_MAX_FLATLINE &&
+                         quality.line_noise <= SQI_MAX_LINE_NOISE &&
+                         quality.gaps <= SQI_MAX_GAPS;
+
+        float worst = quality.saturation / SQI_MAX_SATURATION;
+        worst = std::max(worst, quality.flatline / SQI_MAX_FLATLINE);
+        worst = std::max(worst, quality.line_noise / SQI_MAX_LINE_NOISE);
+        worst = std::max(worst, (float)quality.gaps / (SQI_MAX_GAPS + 1));
+        quality.score = worst < 1.0f ? 1.0f - worst : 0.0f;
+    }
+
+private:
+    uint8_t flags[WINDOW_SIZE];
+    int saturated_count;
+    int flat_count;
+    int gap_count;
+
+    int last_adc;
+    int run_length;
+    bool pending_gap;
+
+    GoertzelBank<50, 60> line;
+    int line_bin;
+};
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file BITalinoEEG_Resampler.h
+ * @brief Rééchantillonneur rationnel polyphase (fréquence d'acquisition → SAMPLE_RATE)
+ *
+ * Le BITalino échantillonne à 1, 10, 100 ou 1000 Hz ; le modèle a été
+ * entraîné à SAMPLE_RATE = 178 Hz. Le rapport OutputRate / InputRate est
+ * réduit en Up / Down (1000 → 178 : 89 / 500, 100 → 178 : 89 / 50).
+ *
+ * Filtre prototype : sinc fenêtré (Hamming) de Up × TapsPerPhase
+ * coefficients à Up · InputRate, coupure à min(InputRate, OutputRate) / 2.
+ * Il est rangé en Up phases de TapsPerPhase coefficients : chaque sortie
+ * n'évalue que la phase qui lui correspond (TapsPerPhase
+ * multiplications-additions), sans jamais calculer les échantillons
+ * intermédiaires ni filtrer à la cadence d'entrée. Chaque phase est
+ * normalisée à un gain continu de 1.
+ *
+ * Avec TapsPerPhase = 32 à 1000 Hz (Hamming, transition ~3.3 · InputRate /
+ * TapsPerPhase) : −0.07 dB à 40 Hz, −44 dB à 138 Hz (replié sur 40 Hz),
+ * −53 dB à 160 Hz. Retard de groupe : ~TapsPerPhase / 2 échantillons
+ * d'entrée (16 ms à 1000 Hz, 160 ms à 100 Hz).
+ *
+ * Historique : buffer circulaire miroir comme celui du préprocesseur, la
+ * fenêtre du produit scalaire est toujours contiguë.
+ */
+
+#ifndef BITALINO_EEG_RESAMPLER_H
+#define BITALINO_EEG_RESAMPLER_H
+
+#include <cmath>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_DSP.h"
+
+#ifndef RESAMPLER_TAPS_PER_PHASE
+#define RESAMPLER_TAPS_PER_PHASE 32
+#endif
+
+constexpr int resamplerGcd(int a, int b)
+{
+    return b == 0 ? a : resamplerGcd(b, a % b);
+}
+
+/**
+ * @brief Rééchantillonneur InputRate → OutputRate (Hz entiers)
+ */
+template <int InputRate, int OutputRate = SAMPLE_RATE, int TapsPerPhase = RESAMPLER_TAPS_PER_PHASE>
+class PolyphaseResampler
+{
+public:
+    static const int Up = OutputRate / resamplerGcd(InputRate, OutputRate);
+    static const int Down = InputRate / resamplerGcd(InputRate, OutputRate);
+    static const int NumTaps = Up * TapsPerPhase;
+
+    static_assert(InputRate > 0 && OutputRate > 0, "fréquences positives");
+    static_assert(TapsPerPhase >= 2, "au moins 2 coefficients par phase");
+
+    /**
+     * @brief Nombre maximal de sorties pour n entrées (taille du tampon de sortie)
+     */
+    static constexpr int maxOutput(int n)
+    {
+        return n * Up / Down + 1;
+    }
+
+    PolyphaseResampler()
+    {
+        const double cutoff = 0.5 * (InputRate < OutputRate ? InputRate : OutputRate) / ((double)Up * InputRate);
+        const double center = (NumTaps - 1) / 2.0;
+
+        for (int p = 0; p < Up; p++)
+        {
+            double phase_taps[TapsPerPhase];
+            double sum = 0;
+            for (int k = 0; k < TapsPerPhase; k++)
+            {
+                int j = p + k * Up;
+                double t = j - center;
+                double sinc = t == 0 ? 1.0 : std::sin(2 * M_PI * cutoff * t) / (2 * M_PI * cutoff * t);
+                double window = 0.54 - 0.46 * std::cos(2 * M_PI * j / (NumTaps - 1));
+                phase_taps[k] = sinc * window;
+                sum += phase_taps[k];
+            }
+
+            // Ordre inversé : le coefficient k multiplie x[n − k], le plus
+            // récent est à la fin de la fenêtre de l'historique
+            for (int k = 0; k < TapsPerPhase; k++)
+            {
+                taps[p][TapsPerPhase - 1 - k] = (float)(phase_taps[k] / sum);
+            }
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        for (int i = 0; i < 2 * TapsPerPhase; i++)
+            history[i] = 0;
+        write_index = 0;
+        phase = Up;
+    }
+
+    /**
+     * @brief Rééchantillonner un bloc d'échantillons
+     * @param in n échantillons à InputRate
+     * @param out Au moins maxOutput(n) valeurs à OutputRate
+     * @return Nombre d'échantillons écrits dans out
+     */
+    int process(const float *in, int n, float *out)
+    {
+        int produced = 0;
+        for (int i = 0; i < n; i++)
+        {
+            push(in[i]);
+            while (phase < Up)
+                out[produced++] = next();
+        }
+        return produced;
+    }
+
+    /**
+     * @brief Variante ADC : valeurs entières en entrée, sorties arrondies
+     */
+    int process(const int *in, int n, int *out)
+    {
+        int produced = 0;
+        for (int i = 0; i < n; i++)
+        {
+            push((float)in[i]);
+            while (phase < Up)
+                out[produced++] = (int)std::lround(next());
+        }
+        return produced;
+    }
+
+private:
+    float taps[Up][TapsPerPhase];
+    float history[2 * TapsPerPhase];
+    int write_index;
+
+    // Position de la prochaine sortie sur la grille Up · InputRate, relative
+    // au dernier échantillon d'entrée (sortie due tant que phase < Up)
+    int phase;
+
+    void push(float x)
+    {
+        history[write_index] = x;
+        history[write_index + TapsPerPhase] = x;
+        write_index = write_index + 1 == TapsPerPhase ? 0 : write_index + 1;
+        phase -= Up;
+    }
+
+    float next()
+    {
+        float y = dspDotProduct(taps[phase], &history[write_index], TapsPerPhase);
+        phase += Down;
+        return y;
+    }
+};
+
+#endif
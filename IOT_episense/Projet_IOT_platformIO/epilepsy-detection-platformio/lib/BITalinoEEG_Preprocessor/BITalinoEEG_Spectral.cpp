@@ -0,0 +1,268 @@
+/**
+ * @file BITalinoEEG_Spectral.cpp
+ * @brief Implémentation de la FFT réelle et des features spectrales
+ *
+ */
+
+#include "BITalinoEEG_Spectral.h"
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_FastMath.h"
+#include <cmath>
+#include <stdint.h>
+
+#define HALF_FFT_SIZE (SPECTRAL_FFT_SIZE / 2)
+
+// Twiddles e^(-2iπk/N) pour k = 0..N/2 ; la FFT complexe de N/2 points
+// utilise les indices pairs.
+static float twiddle_cos[HALF_FFT_SIZE + 1];
+static float twiddle_sin[HALF_FFT_SIZE + 1];
+static uint8_t bit_reverse[HALF_FFT_SIZE];
+static float hann_window[WINDOW_SIZE];
+static float psd_scale;
+static bool tables_ready = false;
+
+// Bornes [début, fin) des bandes en bins ; la dernière entrée couvre 0.5-45 Hz
+static const float BAND_EDGES[NUM_SPECTRAL_BANDS + 1] = {0.5f, 4.0f, 8.0f, 13.0f, 30.0f, 45.0f};
+static int band_first_bin[NUM_SPECTRAL_BANDS + 1];
+static int band_end_bin[NUM_SPECTRAL_BANDS + 1];
+
+// Buffers de travail (pas d'allocation, non réentrant)
+static float fft_input[SPECTRAL_FFT_SIZE];
+static float fft_output[2 * SPECTRAL_NUM_BINS];
+static float complex_buffer[SPECTRAL_FFT_SIZE];
+static float psd_buffer[SPECTRAL_NUM_BINS];
+
+static int frequencyToBin(float frequency)
+{
+    return (int)std::ceil(frequency * SPECTRAL_FFT_SIZE / SAMPLE_RATE);
+}
+
+static void initTables()
+{
+    for (int k = 0; k <= HALF_FFT_SIZE; k++)
+    {
+        double angle = 2.0 * M_PI * k / SPECTRAL_FFT_SIZE;
+        twiddle_cos[k] = (float)std::cos(angle);
+        twiddle_sin[k] = (float)std::sin(angle);
+    }
+
+    int bits = 0;
+    while ((1 << bits) < HALF_FFT_SIZE)
+        bits++;
+    for (int i = 0; i < HALF_FFT_SIZE; i++)
+    {
+        int reversed = 0;
+        for (int b = 0; b < bits; b++)
+        {
+            if (i & (1 << b))
+                reversed |= 1 << (bits - 1 - b);
+        }
+        bit_reverse[i] = (uint8_t)reversed;
+    }
+
+    double window_energy = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        double w = 0.5 - 0.5 * std::cos(2.0 * M_PI * i / (WINDOW_SIZE - 1));
+        hann_window[i] = (float)w;
+        window_energy += w * w;
+    }
+    psd_scale = (float)(1.0 / (SAMPLE_RATE * window_energy));
+
+    for (int b = 0; b < NUM_SPECTRAL_BANDS; b++)
+    {
+        band_first_bin[b] = frequencyToBin(BAND_EDGES[b]);
+        band_end_bin[b] = frequencyToBin(BAND_EDGES[b + 1]);
+    }
+    band_first_bin[NUM_SPECTRAL_BANDS] = band_first_bin[0];
+    band_end_bin[NUM_SPECTRAL_BANDS] = band_end_bin[NUM_SPECTRAL_BANDS - 1];
+
+    tables_ready = true;
+}
+
+// FFT complexe radix-2 en place sur HALF_FFT_SIZE valeurs entrelacées
+static void complexFFT(float *data)
+{
+    for (int i = 0; i < HALF_FFT_SIZE; i++)
+    {
+        int j = bit_reverse[i];
+        if (j > i)
+        {
+            float re = data[2 * i];
+            float im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    for (int length = 2; length <= HALF_FFT_SIZE; length <<= 1)
+    {
+        int half = length / 2;
+        int stride = SPECTRAL_FFT_SIZE / length;
+
+        for (int start = 0; start < HALF_FFT_SIZE; start += length)
+        {
+            for (int j = 0; j < half; j++)
+            {
+                float w_re = twiddle_cos[j * stride];
+                float w_im = -twiddle_sin[j * stride];
+
+                float *a = &data[2 * (start + j)];
+                float *b = &data[2 * (start + j + half)];
+
+                float t_re = b[0] * w_re - b[1] * w_im;
+                float t_im = b[0] * w_im + b[1] * w_re;
+
+                b[0] = a[0] - t_re;
+                b[1] = a[1] - t_im;
+                a[0] += t_re;
+                a[1] += t_im;
+            }
+        }
+    }
+}
+
+void spectralRealFFT(const float *in, float *out)
+{
+    if (!tables_ready)
+        initTables();
+
+    // z[n] = x[2n] + i·x[2n+1]
+    for (int i = 0; i < SPECTRAL_FFT_SIZE; i++)
+    {
+        complex_buffer[i] = in[i];
+    }
+    complexFFT(complex_buffer);
+
+    // X[k] = E[k] + W^k·O[k], avec E = (Z[k] + Z*[N/2−k]) / 2 et
+    // O = (Z[k] − Z*[N/2−k]) / 2i
+    for (int k = 0; k <= HALF_FFT_SIZE; k++)
+    {
+        int k1 = k == HALF_FFT_SIZE ? 0 : k;
+        int k2 = k == 0 ? 0 : HALF_FFT_SIZE - k;
+
+        float z_re = complex_buffer[2 * k1];
+        float z_im = complex_buffer[2 * k1 + 1];
+        float c_re = complex_buffer[2 * k2];
+        float c_im = -complex_buffer[2 * k2 + 1];
+
+        float e_re = 0.5f * (z_re + c_re);
+        float e_im = 0.5f * (z_im + c_im);
+        float o_re = 0.5f * (z_im - c_im);
+        float o_im = -0.5f * (z_re - c_re);
+
+        float w_re = twiddle_cos[k];
+        float w_im = -twiddle_sin[k];
+
+        out[2 * k] = e_re + o_re * w_re - o_im * w_im;
+        out[2 * k + 1] = e_im + o_re * w_im + o_im * w_re;
+    }
+}
+
+void computePowerSpectrum(const float *window, float *psd)
+{
+    if (!tables_ready)
+        initTables();
+
+    float mean = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        mean += window[i];
+    }
+    mean /= WINDOW_SIZE;
+
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        fft_input[i] = (window[i] - mean) * hann_window[i];
+    }
+    for (int i = WINDOW_SIZE; i < SPECTRAL_FFT_SIZE; i++)
+    {
+        fft_input[i] = 0;
+    }
+
+    spectralRealFFT(fft_input, fft_output);
+
+    for (int k = 0; k < SPECTRAL_NUM_BINS; k++)
+    {
+        float re = fft_output[2 * k];
+        float im = fft_output[2 * k + 1];
+        float power = (re * re + im * im) * psd_scale;
+
+        // Spectre unilatéral : DC et Nyquist ne sont pas doublés
+        psd[k] = (k == 0 || k == HALF_FFT_SIZE) ? power : 2.0f * power;
+    }
+}
+
+void computeSpectralFeatures(const float *window, float *out)
+{
+    const float bin_width = (float)SAMPLE_RATE / SPECTRAL_FFT_SIZE;
+
+    computePowerSpectrum(window, psd_buffer);
+
+    float band_power[NUM_SPECTRAL_BANDS];
+    for (int b = 0; b < NUM_SPECTRAL_BANDS; b++)
+    {
+        float sum = 0;
+        for (int k = band_first_bin[b]; k < band_end_bin[b]; k++)
+        {
+            sum += psd_buffer[k];
+        }
+        band_power[b] = sum * bin_width;
+    }
+
+    int first = band_first_bin[NUM_SPECTRAL_BANDS];
+    int end = band_end_bin[NUM_SPECTRAL_BANDS];
+
+    float total = 0;
+    int peak_bin = first;
+    for (int k = first; k < end; k++)
+    {
+        total += psd_buffer[k];
+        if (psd_buffer[k] > psd_buffer[peak_bin])
+            peak_bin = k;
+    }
+
+    float sef50 = 0;
+    float sef90 = 0;
+    float entropy = 0;
+    float cumulative = 0;
+    bool sef50_found = false;
+    bool sef90_found = false;
+
+    for (int k = first; k < end; k++)
+    {
+        cumulative += psd_buffer[k];
+        if (!sef50_found && cumulative >= 0.5f * total)
+        {
+            sef50 = k * bin_width;
+            sef50_found = true;
+        }
+        if (!sef90_found && cumulative >= 0.9f * total)
+        {
+            sef90 = k * bin_width;
+            sef90_found = true;
+        }
+
+        if (total > 0 && psd_buffer[k] > 0)
+        {
+            float p = psd_buffer[k] / total;
+            entropy -= p * eegLog(p);
+        }
+    }
+    entropy /= std::log((float)(end - first));
+
+    float total_power = total * bin_width;
+    for (int b = 0; b < NUM_SPECTRAL_BANDS; b++)
+    {
+        out[b] = band_power[b];
+        out[NUM_SPECTRAL_BANDS + b] = band_power[b] / (total_power + 1e-8f);
+    }
+    out[10] = total_power;
+    out[11] = peak_bin * bin_width;
+    out[12] = sef50;
+    out[13] = sef90;
+    out[14] = entropy;
+    out[15] = (band_power[0] + band_power[1]) / (band_power[2] + band_power[3] + 1e-8f);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file BITalinoEEG_Spectral.h
+ * @brief Étage de features spectrales (puissances de bandes EEG)
+ *
+ * La fenêtre filtrée (WINDOW_SIZE échantillons) est centrée, pondérée par une
+ * fenêtre de Hann et complétée par des zéros jusqu'à SPECTRAL_FFT_SIZE. La
+ * FFT réelle est calculée par une FFT complexe de taille N/2 suivie d'une
+ * étape de séparation ; toutes les tables (twiddles, bit-reversal, Hann,
+ * bornes des bandes) sont statiques et initialisées une seule fois.
+ *
+ * Résolution : SAMPLE_RATE / SPECTRAL_FFT_SIZE = 0.695 Hz par bin. Un
+ * moyennage de Welch sur les 7 segments (25 échantillons, 7.1 Hz par bin) ne
+ * sépare pas delta et thêta, d'où le périodogramme sur la fenêtre entière.
+ *
+ * Features (NUM_SPECTRAL_FEATURES) :
+ *  0-4   puissance absolue delta, thêta, alpha, bêta, gamma (µV²)
+ *  5-9   puissance relative des mêmes bandes
+ *  10    puissance totale 0.5-45 Hz (µV²)
+ *  11    fréquence du pic (Hz)
+ *  12    fréquence médiane (SEF50, Hz)
+ *  13    fréquence de bord spectral (SEF90, Hz)
+ *  14    entropie spectrale normalisée (0-1)
+ *  15    rapport de ralentissement (delta + thêta) / (alpha + bêta)
+ */
+
+#ifndef BITALINO_EEG_SPECTRAL_H
+#define BITALINO_EEG_SPECTRAL_H
+
+#define SPECTRAL_FFT_SIZE 256
+#define SPECTRAL_NUM_BINS (SPECTRAL_FFT_SIZE / 2 + 1)
+#define NUM_SPECTRAL_BANDS 5
+#define NUM_SPECTRAL_FEATURES 16
+
+#define SPECTRAL_MIN_FREQ 0.5f
+#define SPECTRAL_MAX_FREQ 45.0f
+
+/**
+ * @brief FFT réelle de SPECTRAL_FFT_SIZE points
+ * @param in SPECTRAL_FFT_SIZE échantillons réels
+ * @param out SPECTRAL_NUM_BINS valeurs complexes entrelacées (re, im)
+ */
+void spectralRealFFT(const float *in, float *out);
+
+/**
+ * @brief Densité spectrale de puissance unilatérale de la fenêtre (µV²/Hz)
+ * @param window WINDOW_SIZE échantillons filtrés
+ * @param psd SPECTRAL_NUM_BINS valeurs
+ */
+void computePowerSpectrum(const float *window, float *psd);
+
+/**
+ * @brief Calculer les NUM_SPECTRAL_FEATURES features spectrales
+ * @param window WINDOW_SIZE échantillons filtrés
+ * @param out Tableau de sortie
+ */
+void computeSpectralFeatures(const float *window, float *out);
+
+#endif
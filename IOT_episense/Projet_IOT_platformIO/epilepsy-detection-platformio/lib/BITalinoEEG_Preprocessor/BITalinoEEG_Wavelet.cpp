@@ -0,0 +1,24 @@
+/**
+ * @file BITalinoEEG_Wavelet.cpp
+ * @brief Gains de normalisation des ondelettes et étage de features
+ *
+ */
+
+#include "BITalinoEEG_Wavelet.h"
+#include <cstring>
+
+// Gain à appliquer aux approximations après lifting pour un gain DC de √2
+// (les détails reçoivent l'inverse)
+const float HaarWavelet::LOW_GAIN = 1.41421356f;
+const float LeGall53Wavelet::LOW_GAIN = 1.41421356f;
+const float CDF97Wavelet::LOW_GAIN = 1.14960430f;
+
+// La fenêtre courante est partagée entre fenêtres qui se recouvrent : la
+// transformée travaille en place sur une copie.
+static float wavelet_scratch[WINDOW_SIZE];
+
+void computeWaveletFeatures(const float *window, float *out)
+{
+    memcpy(wavelet_scratch, window, sizeof(wavelet_scratch));
+    EEGWaveletTransform::transform(wavelet_scratch, WINDOW_SIZE, out);
+}
@@ -0,0 +1,211 @@
+/**
+ * @file BITalinoEEG_Wavelet.h
+ * @brief Transformée en ondelettes discrète par lifting, en place
+ *
+ * Les coefficients restent entrelacés dans le tableau d'entrée : au niveau l,
+ * les approximations occupent les indices multiples de 2^l et les détails
+ * les indices impairs de ce pas. Aucune mémoire auxiliaire hormis quelques
+ * registres. Les bords sont traités par extension symétrique, ce qui permet
+ * des longueurs impaires (178 → 89 → 45 → 23 → 12 → 6).
+ *
+ * Ondelettes disponibles (paramètre template, étapes déroulées) :
+ *  - HaarWavelet : orthonormale, 1 moment nul ;
+ *  - LeGall53Wavelet : biorthogonale 5/3, 2 moments nuls ;
+ *  - CDF97Wavelet : biorthogonale 9/7 (JPEG 2000), 4 moments nuls.
+ * Les approximations sont normalisées pour un gain DC de √2 par niveau.
+ *
+ * Features (3 par bande, bandes D1..DL puis AL) : énergie Σc², écart-type,
+ * énergie relative. Énergie et écart-type sont accumulés pendant l'étape de
+ * normalisation de chaque niveau.
+ */
+
+#ifndef BITALINO_EEG_WAVELET_H
+#define BITALINO_EEG_WAVELET_H
+
+#include <cmath>
+#include "BITalinoEEG_Config.h"
+#include "BITalinoEEG_FastMath.h"
+
+#define WAVELET_FEATURES_PER_BAND 3
+
+/**
+ * @brief Échantillon voisin avec extension symétrique (i peut valoir −1 ou n)
+ */
+inline float liftingNeighbor(const float *x, int i, int n, int stride)
+{
+    if (i < 0)
+        i = -i;
+    else if (i >= n)
+        i = 2 * (n - 1) - i;
+    return x[i * stride];
+}
+
+/**
+ * @brief Étape de prédiction : impairs += c·(pair gauche + pair droit)
+ */
+inline void liftingPredict(float *x, int n, int stride, float c)
+{
+    for (int i = 1; i < n; i += 2)
+    {
+        x[i * stride] += c * (x[(i - 1) * stride] + liftingNeighbor(x, i + 1, n, stride));
+    }
+}
+
+/**
+ * @brief Étape de mise à jour : pairs += c·(impair gauche + impair droit)
+ */
+inline void liftingUpdate(float *x, int n, int stride, float c)
+{
+    if (n < 2)
+        return;
+    for (int i = 0; i < n; i += 2)
+    {
+        x[i * stride] += c * (liftingNeighbor(x, i - 1, n, stride) + liftingNeighbor(x, i + 1, n, stride));
+    }
+}
+
+struct HaarWavelet
+{
+    static const float LOW_GAIN;
+
+    static void lift(float *x, int n, int stride)
+    {
+        for (int i = 1; i < n; i += 2)
+        {
+            float &even = x[(i - 1) * stride];
+            float &odd = x[i * stride];
+            odd -= even;
+            even += 0.5f * odd;
+        }
+    }
+};
+
+struct LeGall53Wavelet
+{
+    static const float LOW_GAIN;
+
+    static void lift(float *x, int n, int stride)
+    {
+        liftingPredict(x, n, stride, -0.5f);
+        liftingUpdate(x, n, stride, 0.25f);
+    }
+};
+
+struct CDF97Wavelet
+{
+    static const float LOW_GAIN;
+
+    static void lift(float *x, int n, int stride)
+    {
+        liftingPredict(x, n, stride, -1.586134342f);
+        liftingUpdate(x, n, stride, -0.05298011854f);
+        liftingPredict(x, n, stride, 0.8829110762f);
+        liftingUpdate(x, n, stride, 0.4435068522f);
+    }
+};
+
+/**
+ * @brief DWT à Levels niveaux par lifting, features calculées pendant la transformée
+ */
+template <class Wavelet, int Levels>
+class LiftingDWT
+{
+public:
+    static const int NumBands = Levels + 1;
+    static const int NumFeatures = WAVELET_FEATURES_PER_BAND * NumBands;
+
+    static_assert(Levels >= 1 && (WINDOW_SIZE >> Levels) >= 2, "trop de niveaux pour WINDOW_SIZE");
+
+    /**
+     * @brief Transformer data en place et écrire les NumFeatures features
+     * @param data length échantillons, remplacés par les coefficients entrelacés
+     * @param out Tableau de sortie (NumFeatures éléments)
+     */
+    static void transform(float *data, int length, float *out)
+    {
+        float energy[NumBands];
+        float total_energy = 0;
+        int n = length;
+        int stride = 1;
+
+        for (int level = 0; level < Levels; level++)
+        {
+            Wavelet::lift(data, n, stride);
+
+            // Normalisation (gain DC √2 pour les approximations) fusionnée
+            // avec l'accumulation des statistiques des détails
+            const float low = Wavelet::LOW_GAIN;
+            const float high = 1.0f / Wavelet::LOW_GAIN;
+            float sum = 0;
+            float sum_sq = 0;
+            for (int i = 0; i < n; i += 2)
+            {
+                data[i * stride] *= low;
+            }
+            for (int i = 1; i < n; i += 2)
+            {
+                float c = data[i * stride] * high;
+                data[i * stride] = c;
+                sum += c;
+                sum_sq += c * c;
+            }
+
+            int count = n / 2;
+            writeBand(out, level, sum, sum_sq, count);
+            energy[level] = sum_sq;
+            total_energy += sum_sq;
+
+            n = (n + 1) / 2;
+            stride *= 2;
+        }
+
+        float sum = 0;
+        float sum_sq = 0;
+        for (int i = 0; i < n; i++)
+        {
+            float c = data[i * stride];
+            sum += c;
+            sum_sq += c * c;
+        }
+        writeBand(out, Levels, sum, sum_sq, n);
+        energy[Levels] = sum_sq;
+        total_energy += sum_sq;
+
+        for (int band = 0; band < NumBands; band++)
+        {
+            out[band * WAVELET_FEATURES_PER_BAND + 2] = energy[band] / (total_energy + 1e-8f);
+        }
+    }
+
+private:
+    static void writeBand(float *out, int band, float sum, float sum_sq, int count)
+    {
+        float mean = sum / count;
+        float variance = sum_sq / count - mean * mean;
+        out[band * WAVELET_FEATURES_PER_BAND] = sum_sq;
+        out[band * WAVELET_FEATURES_PER_BAND + 1] = eegSqrt(variance > 0 ? variance : 0);
+    }
+};
+
+// Configuration du préprocesseur
+#ifndef EEG_DWT_WAVELET
+#define EEG_DWT_WAVELET CDF97Wavelet
+#endif
+
+#ifndef EEG_DWT_LEVELS
+#define EEG_DWT_LEVELS 5
+#endif
+
+typedef LiftingDWT<EEG_DWT_WAVELET, EEG_DWT_LEVELS> EEGWaveletTransform;
+
+#define NUM_WAVELET_FEATURES (WAVELET_FEATURES_PER_BAND * (EEG_DWT_LEVELS + 1))
+
+/**
+ * @brief Features ondelettes d'une fenêtre (copie dans un tampon statique,
+ *        puis transformée en place ; non réentrant)
+ * @param window WINDOW_SIZE échantillons filtrés
+ * @param out NUM_WAVELET_FEATURES valeurs
+ */
+void computeWaveletFeatures(const float *window, float *out);
+
+#endif
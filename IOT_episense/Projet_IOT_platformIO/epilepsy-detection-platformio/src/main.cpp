@@ -7,7 +7,21 @@
 #include <ArduinoJson.h>
 
 #include "BITalinoEEG_Preprocessor.h"
+#include "BITalinoEEG_Resampler.h"
+#include "BITalinoEEG_Frame.h"
+#ifdef EEG_SCALER_FOLDED
+// Modèle à scaler intégré (convert_model.py epilepsy_model_folded.tflite) :
+// le modèle standard attend des features normalisées
+#include "model_data_folded.h"
+#ifndef MODEL_SCALER_FOLDED
+#error "EEG_SCALER_FOLDED : model_data_folded.h ne vient pas d'un modèle à scaler intégré"
+#endif
+#else
 #include "model_data.h"
+#ifdef MODEL_SCALER_FOLDED
+#error "Modèle à scaler intégré : compiler avec -DEEG_SCALER_FOLDED (env:esp32dev_folded)"
+#endif
+#endif
 #include "../../include/scaler_params.h"
 
 #include <TensorFlowLite_ESP32.h>
@@ -33,7 +47,7 @@ const char *TOPIC_COMMAND = "epilepsy/command";
 const char *TOPIC_RAW_EEG = "epilepsy/raw_eeg";
 
 void publishStatus(const char *state, const char *message);
-void publishPrediction(float prediction, bool is_seizure);
+void publishPrediction(float prediction, bool is_seizure, float quality);
 void publishAlert(bool seizure_active, unsigned long duration_ms);
 void publishMetrics();
 void publishRawEEG(int raw_value, float microvolts);
@@ -44,10 +58,27 @@ void publishRawEEG(int raw_value, float microvolts);
 
 uint8_t BITALINO_MAC_ADDRESS[6] = {0x20, 0x17, 0x11, 0x20, 0x49, 0x95};
 
-#define SAMPLING_RATE 100
-#define WINDOW_SIZE 178
-#define OVERLAP_PERCENTAGE 50
-#define OVERLAP_SIZE (WINDOW_SIZE * OVERLAP_PERCENTAGE / 100)
+// Fréquence d'acquisition du BITalino (1, 10, 100 ou 1000 Hz), ramenée à
+// SAMPLE_RATE (178 Hz, fréquence d'entraînement du modèle) par le
+// rééchantillonneur polyphase avant le préprocesseur
+#define SAMPLING_RATE 1000
+
+#if SAMPLING_RATE == 1000
+#define BITALINO_RATE_CODE 0xC3
+#elif SAMPLING_RATE == 100
+#define BITALINO_RATE_CODE 0x83
+#elif SAMPLING_RATE == 10
+#define BITALINO_RATE_CODE 0x43
+#elif SAMPLING_RATE == 1
+#define BITALINO_RATE_CODE 0x03
+#else
+#error "SAMPLING_RATE : 1, 10, 100 ou 1000 Hz"
+#endif
+
+// Voies acquises : A1 seule (capteur EEG). La taille des trames en dépend
+// (3 octets pour une voie, voir BITalinoEEG_Frame.h)
+#define BITALINO_CHANNEL_MASK 0x01
+#define BITALINO_ACQ_CHANNELS 1
 
 #define TENSOR_ARENA_SIZE 30000
 #define SEIZURE_THRESHOLD 0.7
@@ -61,6 +92,7 @@ PubSubClient mqttClient(espClient);
 BluetoothSerial SerialBT;
 
 BITalinoEEGPreprocessor preprocessor;
+CascadeGate cascade;
 
 tflite::MicroErrorReporter micro_error_reporter;
 tflite::ErrorReporter *error_reporter = &micro_error_reporter;
@@ -81,44 +113,35 @@ unsigned long last_raw_signal_publish = 0;
 float current_prediction = 0.0f;
 int current_heart_rate = 0;
 
-uint8_t bt_buffer[6];
-int bt_index = 0;
+BITalinoFrameDecoder<BITALINO_ACQ_CHANNELS> frame_decoder;
+
+int sample_block[INGEST_BLOCK_SIZE];
+int sample_block_count = 0;
+
+#if SAMPLING_RATE != SAMPLE_RATE
+PolyphaseResampler<SAMPLING_RATE> resampler;
+int resampled_block[PolyphaseResampler<SAMPLING_RATE>::maxOutput(INGEST_BLOCK_SIZE)];
+#endif
 
 unsigned long total_inferences = 0;
 unsigned long total_seizures = 0;
+unsigned long skipped_windows = 0;
 unsigned long system_start_time = 0;
 
-typedef struct
-{
-    uint8_t seq;
-    uint8_t digital[4];
-    uint16_t analog[6];
-} BITalinoFrame;
-
-bool parseBITalinoFrame(uint8_t *buffer, BITalinoFrame *frame)
-{
-    if (!(buffer[0] & 0x80))
-        return false;
-
-    frame->seq = buffer[0] & 0x0F;
-    frame->digital[0] = (buffer[0] >> 7) & 0x01;
-    frame->digital[1] = (buffer[0] >> 6) & 0x01;
-    frame->digital[2] = (buffer[0] >> 5) & 0x01;
-    frame->digital[3] = (buffer[0] >> 4) & 0x01;
-
-    frame->analog[0] = ((buffer[1] & 0x03) << 8) | buffer[2];
-
-    frame->analog[1] = ((buffer[3] & 0x0F) << 6) | (buffer[4] >> 2);
-
-    return true;
-}
-
 void startBITalinoAcquisition()
 {
-    uint8_t start_cmd[] = {0x01, 0x07};
-    SerialBT.write(start_cmd, 2);
+    uint8_t rate_cmd[] = {BITALINO_RATE_CODE};
+    SerialBT.write(rate_cmd, 1);
+    delay(100);
+
+    // Mode live : 0bA6A5A4A3A2A1 01
+    uint8_t start_cmd[] = {(uint8_t)((BITALINO_CHANNEL_MASK << 2) | 0x01)};
+    SerialBT.write(start_cmd, 1);
     delay(100);
-    Serial.println("✓ Acquisition BITalino démarrée (178 Hz)");
+
+    // Nouveau flux : la première trame ne doit pas compter comme un trou
+    frame_decoder.reset();
+    Serial.printf("✓ Acquisition BITalino démarrée (%d Hz → %d Hz)\n", SAMPLING_RATE, SAMPLE_RATE);
 }
 
 void stopBITalinoAcquisition()
@@ -171,6 +194,12 @@ void mqttCallback(char *topic, byte *payload, unsigned int length)
         {
             Serial.println("🔄 Reset via MQTT");
             preprocessor.reset();
+#if SAMPLING_RATE != SAMPLE_RATE
+            resampler.reset();
+#endif
+            cascade.reset();
+            frame_decoder.reset();
+            sample_block_count = 0;
             seizure_detected = false;
             digitalWrite(LED_RED, LOW);
             digitalWrite(LED_YELLOW, HIGH);
@@ -227,7 +256,7 @@ void publishStatus(const char *state, const char *message)
     mqttClient.publish(TOPIC_STATUS, buffer, true);
 }
 
-void publishPrediction(float prediction, bool is_seizure)
+void publishPrediction(float prediction, bool is_seizure, float quality)
 {
     StaticJsonDocument<256> doc;
     doc["timestamp"] = millis();
@@ -235,6 +264,7 @@ void publishPrediction(float prediction, bool is_seizure)
     doc["confidence"] = round((prediction * 100) * 10) / 10.0f;
     doc["is_seizure"] = is_seizure;
     doc["threshold"] = SEIZURE_THRESHOLD;
+    doc["signal_quality"] = round(quality * 100) / 100.0f;
     doc["inference_count"] = total_inferences;
 
     char buffer[256];
@@ -268,6 +298,10 @@ void publishMetrics()
     doc["samples_processed"] = samples_processed;
     doc["total_inferences"] = total_inferences;
     doc["total_seizures"] = total_seizures;
+    doc["skipped_windows"] = skipped_windows;
+    doc["crc_errors"] = frame_decoder.getCRCErrors();
+    doc["gated_windows"] = cascade.getGatedCount();
+    doc["invoked_windows"] = cascade.getInvokedCount();
     doc["current_prediction"] = round(current_prediction * 1000) / 1000.0f;
 
     doc["seizure_detected"] = seizure_detected;
@@ -313,6 +347,131 @@ void updateLEDs(bool seizure)
     }
 }
 
+void runInference()
+{
+    if (preprocessor.extractFeatures())
+    {
+        // Fenêtre inexploitable (saturation, ligne plate, secteur, trames
+        // perdues) : pas d'inférence
+        const SignalQuality &quality = preprocessor.getSignalQuality();
+        if (!quality.usable)
+        {
+            skipped_windows++;
+            if (skipped_windows % 20 == 1)
+            {
+                Serial.printf("⚠️  Signal inexploitable (sat %.0f%%, plat %.0f%%, secteur %.0f%%, trous %d) - %lu fenêtres ignorées\n",
+                              quality.saturation * 100.0f, quality.flatline * 100.0f,
+                              quality.line_noise * 100.0f, quality.gaps, skipped_windows);
+            }
+            return;
+        }
+
+        // Pré-détecteur : réseau invoqué seulement pour une fenêtre suspecte,
+        // périodiquement, ou tant qu'une crise est en cours
+        if (!cascade.shouldInvoke(preprocessor.getWindowActivity(), seizure_detected))
+        {
+            return;
+        }
+
+        // Features écrites directement dans le tenseur d'entrée
+        if (input->type == kTfLiteInt8)
+        {
+            preprocessor.quantizeFeatures(input->data.int8);
+        }
+        else
+        {
+            preprocessor.normalizeFeatures(input->data.f, NUM_FEATURES);
+        }
+
+        if (interpreter->Invoke() == kTfLiteOk)
+        {
+            float prediction = output->data.f[0];
+            current_prediction = prediction;
+            total_inferences++;
+            samples_processed++;
+
+            bool is_seizure = (prediction >= SEIZURE_THRESHOLD);
+
+            publishPrediction(prediction, is_seizure, quality.score);
+
+            if (is_seizure)
+            {
+                if (!seizure_detected)
+                {
+
+                    seizure_detected = true;
+                    seizure_start_time = millis();
+                    total_seizures++;
+
+                    publishAlert(true, 0);
+
+                    Serial.printf("\n⚠️⚠️⚠️ ALERTE CRISE DÉTECTÉE [%.1f%%] ⚠️⚠️⚠️\n",
+                                  prediction * 100.0f);
+                }
+
+                unsigned long duration = millis() - seizure_start_time;
+
+                if (samples_processed % 5 == 0)
+                {
+                    Serial.printf("⚠️  CRISE EN COURS [%.1f%%] - Durée: %lu s\n",
+                                  prediction * 100.0f, duration / 1000);
+                }
+            }
+            else
+            {
+                if (seizure_detected)
+                {
+
+                    unsigned long duration = millis() - seizure_start_time;
+                    seizure_detected = false;
+
+                    publishAlert(false, duration);
+
+                    Serial.printf("\n✓ Fin de crise - Durée totale: %lu s\n\n",
+                                  duration / 1000);
+                }
+
+                if (samples_processed % 20 == 0)
+                {
+                    Serial.printf("✓ Normal [%.1f%%] - Inférences: %lu\n",
+                                  (1.0f - prediction) * 100.0f, total_inferences);
+                }
+            }
+
+            updateLEDs(seizure_detected);
+        }
+    }
+}
+
+void processSampleBlock()
+{
+    if (sample_block_count == 0)
+        return;
+
+#if SAMPLING_RATE != SAMPLE_RATE
+    const int *samples = resampled_block;
+    size_t remaining = resampler.process(sample_block, sample_block_count, resampled_block);
+#else
+    const int *samples = sample_block;
+    size_t remaining = sample_block_count;
+#endif
+    sample_block_count = 0;
+
+    // Une inférence par fenêtre, chacune alignée sur le hop
+    while (remaining > 0)
+    {
+        uint32_t sequence = preprocessor.getWindowSequence();
+        size_t consumed = preprocessor.addSamples(samples, remaining);
+        samples += consumed;
+        remaining -= consumed;
+
+        if (preprocessor.getWindowSequence() != sequence)
+        {
+            runInference();
+        }
+    }
+}
+
 void setup()
 {
     system_start_time = millis();
@@ -423,6 +582,33 @@ void setup()
     input = interpreter->input(0);
     output = interpreter->output(0);
 
+    if (input->dims->data[input->dims->size - 1] != NUM_FEATURES)
+    {
+        Serial.printf("❌ Entrée du modèle: %d features, scaler: %d\n",
+                      input->dims->data[input->dims->size - 1], NUM_FEATURES);
+        publishStatus("error", "Model input size does not match scaler");
+        while (1)
+            ;
+    }
+
+#ifdef EEG_SCALER_FOLDED
+    // Features brutes (1e-2 à 1e8) : une quantification par tenseur les écrase
+    if (input->type != kTfLiteFloat32)
+    {
+        Serial.println("❌ EEG_SCALER_FOLDED attend un modèle à entrée float32");
+        publishStatus("error", "Folded-scaler firmware needs a float32 model input");
+        while (1)
+            ;
+    }
+#endif
+
+    if (input->type == kTfLiteInt8)
+    {
+        preprocessor.setInputQuantization(input->params.scale, input->params.zero_point);
+        Serial.printf("✓ Entrée INT8 (scale: %g, zero point: %d)\n",
+                      input->params.scale, input->params.zero_point);
+    }
+
     Serial.printf("✓ Tensors alloués (Arena: %d/%d bytes)\n",
                   interpreter->arena_used_bytes(), TENSOR_ARENA_SIZE);
 
@@ -447,6 +633,12 @@ void loop()
         {
             Serial.println("🔄 Reset du système (bouton)");
             preprocessor.reset();
+#if SAMPLING_RATE != SAMPLE_RATE
+            resampler.reset();
+#endif
+            cascade.reset();
+            frame_decoder.reset();
+            sample_block_count = 0;
             seizure_detected = false;
             digitalWrite(LED_RED, LOW);
             digitalWrite(LED_YELLOW, HIGH);
@@ -458,112 +650,40 @@ void loop()
 
     while (SerialBT.available())
     {
-        uint8_t byte_received = SerialBT.read();
+        BITalinoFrame frame;
+        int lost;
 
-        if ((byte_received & 0x80) && bt_index == 0)
+        // Trame complète et CRC valide seulement
+        if (!frame_decoder.push(SerialBT.read(), frame, lost))
         {
-            bt_buffer[bt_index++] = byte_received;
+            continue;
         }
-        else if (bt_index > 0 && bt_index < 6)
-        {
-            bt_buffer[bt_index++] = byte_received;
 
-            if (bt_index == 6)
-            {
-                BITalinoFrame frame;
+        int raw_value = frame.analog[0];
 
-                if (parseBITalinoFrame(bt_buffer, &frame))
-                {
-                    int raw_value = frame.analog[0];
-
-                    if (millis() - last_raw_signal_publish >= RAW_SIGNAL_INTERVAL_MS)
-                    {
-                        publishRawEEG(raw_value, preprocessor.convertADCtoMicrovolts(raw_value));
-                        last_raw_signal_publish = millis();
-                    }
-
-                    if (preprocessor.addSample(raw_value))
-                    {
-                        if (preprocessor.extractFeatures())
-                        {
-                            preprocessor.normalizeFeatures();
-
-                            float *normalized = preprocessor.getNormalizedFeatures();
-                            for (int i = 0; i < 194; i++)
-                            {
-                                input->data.f[i] = normalized[i];
-                            }
-
-                            if (interpreter->Invoke() == kTfLiteOk)
-                            {
-                                float prediction = output->data.f[0];
-                                current_prediction = prediction;
-                                total_inferences++;
-                                samples_processed++;
-
-                                bool is_seizure = (prediction >= SEIZURE_THRESHOLD);
-
-                                publishPrediction(prediction, is_seizure);
-
-                                if (is_seizure)
-                                {
-                                    if (!seizure_detected)
-                                    {
-
-                                        seizure_detected = true;
-                                        seizure_start_time = millis();
-                                        total_seizures++;
-
-                                        publishAlert(true, 0);
-
-                                        Serial.printf("\n⚠️⚠️⚠️ ALERTE CRISE DÉTECTÉE [%.1f%%] ⚠️⚠️⚠️\n",
-                                                      prediction * 100.0f);
-                                    }
-
-                                    unsigned long duration = millis() - seizure_start_time;
-
-                                    if (samples_processed % 5 == 0)
-                                    {
-                                        Serial.printf("⚠️  CRISE EN COURS [%.1f%%] - Durée: %lu s\n",
-                                                      prediction * 100.0f, duration / 1000);
-                                    }
-                                }
-                                else
-                                {
-                                    if (seizure_detected)
-                                    {
-
-                                        unsigned long duration = millis() - seizure_start_time;
-                                        seizure_detected = false;
-
-                                        publishAlert(false, duration);
-
-                                        Serial.printf("\n✓ Fin de crise - Durée totale: %lu s\n\n",
-                                                      duration / 1000);
-                                    }
-
-                                    if (samples_processed % 20 == 0)
-                                    {
-                                        Serial.printf("✓ Normal [%.1f%%] - Inférences: %lu\n",
-                                                      (1.0f - prediction) * 100.0f, total_inferences);
-                                    }
-                                }
-
-                                updateLEDs(seizure_detected);
-                            }
-                        }
-                    }
-                }
+        // Saut du numéro de séquence : trames perdues ou rejetées par le CRC
+        if (lost > 0)
+        {
+            processSampleBlock();
+            preprocessor.markSampleGap();
+        }
 
-                bt_index = 0;
-            }
+        if (millis() - last_raw_signal_publish >= RAW_SIGNAL_INTERVAL_MS)
+        {
+            publishRawEEG(raw_value, preprocessor.convertADCtoMicrovolts(raw_value));
+            last_raw_signal_publish = millis();
         }
-        else
+
+        sample_block[sample_block_count++] = raw_value;
+
+        if (sample_block_count == INGEST_BLOCK_SIZE)
         {
-            bt_index = 0;
+            processSampleBlock();
         }
     }
 
+    processSampleBlock();
+
     unsigned long now = millis();
     if (now - last_publish_time >= PUBLISH_INTERVAL_MS)
     {
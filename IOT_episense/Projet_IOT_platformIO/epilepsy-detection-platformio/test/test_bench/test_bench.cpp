@@ -0,0 +1,850 @@
+/**
+ * @file test_bench.cpp
+ * @brief Benchmarks des noyaux du préprocesseur EEG (hôte et ESP32)
+ *
+ * Exécution:
+ * - Hôte :  pio test -e native -f test_bench
+ * - ESP32 : pio test -e test -f test_bench
+ *
+ * Chaque benchmark affiche le temps moyen par appel en microsecondes.
+ */
+
+#include <unity.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_FeatureSet.h"
+#include "BITalinoEEG_FastMath.h"
+#include "BITalinoEEG_Median.h"
+#include "BITalinoEEG_Filters.h"
+#include "BITalinoEEG_Fixed.h"
+#include "BITalinoEEG_DSP.h"
+#include "BITalinoEEG_Spectral.h"
+#include "BITalinoEEG_Wavelet.h"
+#include "BITalinoEEG_Complexity.h"
+#include "BITalinoEEG_Preprocessor.h"
+#include "BITalinoEEG_MultiChannel.h"
+#include "BITalinoEEG_Resampler.h"
+#include "scaler_params.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#define BENCH_ITERATIONS 200
+static double benchMicros() { return (double)micros(); }
+#else
+#include <chrono>
+#define BENCH_ITERATIONS 20000
+static double benchMicros()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1000.0;
+}
+#endif
+
+static float bench_signal[4 * WINDOW_SIZE];
+static volatile float bench_sink;
+
+static void printResult(const char *name, double total_us, int iterations)
+{
+    char line[112];
+#ifdef ARDUINO
+    double us = total_us / iterations;
+    snprintf(line, sizeof(line), "  %-40s %10.3f us %10.0f cycles", name, us, us * getCpuFrequencyMhz());
+#else
+    snprintf(line, sizeof(line), "  %-40s %10.3f us", name, total_us / iterations);
+#endif
+    TEST_MESSAGE(line);
+}
+
+static void fillSignal()
+{
+    srand(1234);
+    for (int i = 0; i < 4 * WINDOW_SIZE; i++)
+    {
+        float t = i / (float)SAMPLE_RATE;
+        bench_signal[i] = 40.0f * std::sin(2 * M_PI * 8.0f * t) +
+                          (rand() % 2001 - 1000) / 100.0f;
+    }
+}
+
+// Médiane historique : copie dans un tableau sur la pile + tri complet
+static float sortMedian(const float *data, int length)
+{
+    float temp[WINDOW_SIZE];
+    memcpy(temp, data, length * sizeof(float));
+    std::sort(temp, temp + length);
+    if (length % 2 == 0)
+        return (temp[length / 2 - 1] + temp[length / 2]) / 2.0f;
+    return temp[length / 2];
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void bench_median(void)
+{
+    double start;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        float acc = sortMedian(window, WINDOW_SIZE);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            acc += sortMedian(&window[seg * SEGMENT_SIZE], SEGMENT_SIZE);
+        bench_sink = acc;
+    }
+    printResult("median std::sort (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        float acc = calculateMedian(window, WINDOW_SIZE);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            acc += calculateMedian(&window[seg * SEGMENT_SIZE], SEGMENT_SIZE);
+        bench_sink = acc;
+    }
+    printResult("median selection (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS);
+
+    static SlidingMedian<WINDOW_SIZE> window_median;
+    static SlidingMedian<SEGMENT_SIZE> segment_median[NUM_SEGMENTS];
+    int samples = BENCH_ITERATIONS;
+
+    start = benchMicros();
+    for (int n = 0; n < samples; n++)
+    {
+        const float *window = &bench_signal[n % (3 * WINDOW_SIZE)];
+        window_median.push(window[WINDOW_SIZE - 1]);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            segment_median[seg].push(window[seg * SEGMENT_SIZE + SEGMENT_SIZE - 1]);
+        bench_sink = window_median.median();
+    }
+    printResult("median glissante / echantillon (x8)", benchMicros() - start, samples);
+
+    TEST_PASS();
+}
+
+// Passe-bas historique : forme directe d'ordre 4 avec décalage des historiques
+struct LegacyDirectForm
+{
+    float x[5];
+    float y[5];
+
+    float process(const float *b, const float *a, float sample)
+    {
+        for (int i = 4; i > 0; i--)
+        {
+            x[i] = x[i - 1];
+            y[i] = y[i - 1];
+        }
+        x[0] = sample;
+        y[0] = b[0] * x[0] + b[1] * x[1] + b[2] * x[2] + b[3] * x[3] + b[4] * x[4] -
+               a[1] * y[1] - a[2] * y[2] - a[3] * y[3] - a[4] * y[4];
+        return y[0];
+    }
+};
+
+void bench_bandpass(void)
+{
+    const float hpf_b[5] = {0.9895f, -3.9580f, 5.9370f, -3.9580f, 0.9895f};
+    const float hpf_a[5] = {1.0f, -3.9580f, 5.9162f, -3.9370f, 0.9790f};
+    const float lpf_b[5] = {0.0201f, 0.0804f, 0.1206f, 0.0804f, 0.0201f};
+    const float lpf_a[5] = {1.0f, -1.9644f, 1.7469f, -0.7498f, 0.1327f};
+    const int block = WINDOW_SIZE;
+    static float out[WINDOW_SIZE];
+    double start;
+
+    static LegacyDirectForm hpf;
+    static LegacyDirectForm lpf;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        memset(&hpf, 0, sizeof(hpf));
+        for (int i = 0; i < block; i++)
+            out[i] = lpf.process(lpf_b, lpf_a, hpf.process(hpf_b, hpf_a, bench_signal[i]));
+        bench_sink = out[block - 1];
+    }
+    printResult("HPF+LPF forme directe (178 ech.)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    static BiquadCascade<BANDPASS_NUM_SECTIONS> cascade;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        for (int i = 0; i < block; i++)
+            out[i] = cascade.process(bench_signal[i]);
+        bench_sink = out[block - 1];
+    }
+    printResult("SOS par echantillon (178 ech.)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        cascade.processBlock(bench_signal, out, block);
+        bench_sink = out[block - 1];
+    }
+    printResult("SOS bloc (178 ech.)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    TEST_PASS();
+}
+
+void bench_fixed_point(void)
+{
+    static eeg_fixed_t signal_q[WINDOW_SIZE];
+    static eeg_fixed_t out_q[WINDOW_SIZE];
+    static float out[WINDOW_SIZE];
+    double start;
+
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        signal_q[i] = (eeg_fixed_t)(bench_signal[i] * EEG_FIXED_ONE);
+
+    static BiquadCascade<BANDPASS_NUM_SECTIONS> cascade;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        cascade.processBlock(bench_signal, out, WINDOW_SIZE);
+        bench_sink = out[WINDOW_SIZE - 1];
+    }
+    printResult("SOS float bloc (178 ech.)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    static FixedBiquadCascade<BANDPASS_NUM_SECTIONS> fixed_cascade;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        fixed_cascade.processBlock(signal_q, out_q, WINDOW_SIZE);
+        bench_sink = out_q[WINDOW_SIZE - 1];
+    }
+    printResult("SOS Q30 bloc (178 ech.)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    SegmentStats stats;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeSegmentStats(bench_signal, WINDOW_SIZE, stats);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            computeSegmentStats(&bench_signal[seg * SEGMENT_SIZE], SEGMENT_SIZE, stats);
+        bench_sink = stats.m2;
+    }
+    printResult("stats float (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    FixedSegmentStats fixed_stats;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeFixedSegmentStats(signal_q, WINDOW_SIZE, fixed_stats);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            computeFixedSegmentStats(&signal_q[seg * SEGMENT_SIZE], SEGMENT_SIZE, fixed_stats);
+        fixedToSegmentStats(fixed_stats, stats);
+        bench_sink = stats.m2;
+    }
+    printResult("stats entieres (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    TEST_PASS();
+}
+
+// Compare chaque noyau du backend actif à sa référence portable (temps et valeur)
+void bench_dsp_kernels(void)
+{
+    static float out[WINDOW_SIZE];
+    float state[2] = {0, 0};
+    double start;
+    float acc;
+
+    TEST_MESSAGE("  backend: " EEG_DSP_BACKEND_NAME);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+        bench_sink = dspSumReference(&bench_signal[it % WINDOW_SIZE], WINDOW_SIZE);
+    printResult("somme reference (178)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+        bench_sink = dspSum(&bench_signal[it % WINDOW_SIZE], WINDOW_SIZE);
+    printResult("somme backend (178)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *x = &bench_signal[it % WINDOW_SIZE];
+        bench_sink = dspDotProductReference(x, x, WINDOW_SIZE);
+    }
+    printResult("energie reference (178)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *x = &bench_signal[it % WINDOW_SIZE];
+        bench_sink = dspDotProduct(x, x, WINDOW_SIZE);
+    }
+    printResult("energie backend (178)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        dspBiquadReference(bench_signal, out, WINDOW_SIZE, BANDPASS_SECTIONS[2], state);
+        bench_sink = out[WINDOW_SIZE - 1];
+    }
+    printResult("biquad DF-II reference (178)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        dspBiquad(bench_signal, out, WINDOW_SIZE, BANDPASS_SECTIONS[2], state);
+        bench_sink = out[WINDOW_SIZE - 1];
+    }
+    printResult("biquad DF-II backend (178)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    SegmentStats stats;
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeSegmentStats(bench_signal, WINDOW_SIZE, stats);
+        bench_sink = stats.m2;
+    }
+    printResult("stats fenetre (178)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    // Le backend doit rester dans la tolérance de la référence
+    acc = dspSumReference(bench_signal, WINDOW_SIZE);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f * std::max(1.0f, std::abs(acc)), acc, dspSum(bench_signal, WINDOW_SIZE));
+    acc = dspDotProductReference(bench_signal, bench_signal, WINDOW_SIZE);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * acc, acc, dspDotProduct(bench_signal, bench_signal, WINDOW_SIZE));
+
+    float ref_state[2] = {0, 0};
+    float backend_state[2] = {0, 0};
+    static float ref_out[WINDOW_SIZE];
+    dspBiquadReference(bench_signal, ref_out, WINDOW_SIZE, BANDPASS_SECTIONS[2], ref_state);
+    dspBiquad(bench_signal, out, WINDOW_SIZE, BANDPASS_SECTIONS[2], backend_state);
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::max(1.0f, std::abs(ref_out[i])), ref_out[i], out[i]);
+}
+
+// Budget : une décision par hop (HOP_SIZE / SAMPLE_RATE = 500 ms au défaut)
+void bench_spectral(void)
+{
+    float spectral[NUM_SPECTRAL_FEATURES];
+    float temporal[NUM_TEMPORAL_FEATURES];
+    SegmentStats stats;
+    double start;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeSegmentStats(&bench_signal[it % WINDOW_SIZE], WINDOW_SIZE, stats);
+        writeTemporalFeatures(stats, temporal);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+        {
+            computeSegmentStats(&bench_signal[it % WINDOW_SIZE + seg * SEGMENT_SIZE], SEGMENT_SIZE, stats);
+            writeTemporalFeatures(stats, temporal);
+        }
+        bench_sink = temporal[0];
+    }
+    printResult("features temporelles (layout 1)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeSpectralFeatures(&bench_signal[it % WINDOW_SIZE], spectral);
+        bench_sink = spectral[10];
+    }
+    double spectral_us = (benchMicros() - start) / (BENCH_ITERATIONS / 10);
+    printResult("features spectrales FFT 256", spectral_us, 1);
+
+    double budget_us = 1e6 * HOP_SIZE / SAMPLE_RATE;
+    char line[96];
+    snprintf(line, sizeof(line), "  part du budget par fenetre: %.3f %%", 100.0 * spectral_us / budget_us);
+    TEST_MESSAGE(line);
+
+    // Marge large : l'étage ne doit pas dépasser 1 % du temps entre deux décisions
+    TEST_ASSERT_LESS_THAN(0.01 * budget_us, spectral_us);
+}
+
+// Coût ajouté par l'étage ondelettes par rapport au chemin temporel seul
+void bench_wavelet(void)
+{
+    float wavelet[NUM_WAVELET_FEATURES];
+    float temporal[NUM_TEMPORAL_FEATURES];
+    SegmentStats stats;
+    double start;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeSegmentStats(&bench_signal[it % WINDOW_SIZE], WINDOW_SIZE, stats);
+        writeTemporalFeatures(stats, temporal);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+        {
+            computeSegmentStats(&bench_signal[it % WINDOW_SIZE + seg * SEGMENT_SIZE], SEGMENT_SIZE, stats);
+            writeTemporalFeatures(stats, temporal);
+        }
+        bench_sink = temporal[0];
+    }
+    double temporal_us = (benchMicros() - start) / (BENCH_ITERATIONS / 10);
+    printResult("features temporelles (layout 1)", temporal_us, 1);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        computeWaveletFeatures(&bench_signal[it % WINDOW_SIZE], wavelet);
+        bench_sink = wavelet[0];
+    }
+    double wavelet_us = (benchMicros() - start) / (BENCH_ITERATIONS / 10);
+    printResult("features ondelettes (lifting)", wavelet_us, 1);
+
+    char line[96];
+    snprintf(line, sizeof(line), "  surcout ondelettes / temporel: %.1f %%", 100.0 * wavelet_us / temporal_us);
+    TEST_MESSAGE(line);
+
+    double budget_us = 1e6 * HOP_SIZE / SAMPLE_RATE;
+    TEST_ASSERT_LESS_THAN(0.01 * budget_us, wavelet_us);
+}
+
+// Ingestion des 6 entrées : six préprocesseurs mono-voie contre une instance SoA
+void bench_multichannel(void)
+{
+    const int channels = BITALINO_NUM_ANALOG_CHANNELS;
+    static BITalinoEEGPreprocessor single[channels];
+    static BITalinoMultiChannelPreprocessor<channels> multi;
+    int frame[channels];
+    int frames = BENCH_ITERATIONS * 5;
+    double start;
+
+    for (int c = 0; c < channels; c++)
+        single[c].begin();
+    multi.reset();
+
+    start = benchMicros();
+    for (int n = 0; n < frames; n++)
+    {
+        for (int c = 0; c < channels; c++)
+            single[c].addSample(512 + (int)bench_signal[(n + 17 * c) % (3 * WINDOW_SIZE)]);
+    }
+    bench_sink = single[0].getWindow()[0];
+    printResult("6 x mono-voie / trame", benchMicros() - start, frames);
+
+    start = benchMicros();
+    for (int n = 0; n < frames; n++)
+    {
+        for (int c = 0; c < channels; c++)
+            frame[c] = 512 + (int)bench_signal[(n + 17 * c) % (3 * WINDOW_SIZE)];
+        multi.addFrame(frame);
+    }
+    bench_sink = multi.getWindow(0)[0];
+    printResult("multi-voies SoA / trame", benchMicros() - start, frames);
+
+    char line[96];
+    snprintf(line, sizeof(line), "  memoire: 6 x %u octets contre %u octets",
+             (unsigned)sizeof(BITalinoEEGPreprocessor), (unsigned)sizeof(multi));
+    TEST_MESSAGE(line);
+
+    TEST_PASS();
+}
+
+// Jeu complet contre sous-ensemble élagué (mean, std, rms, zcr : sans médiane)
+void bench_feature_set(void)
+{
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL> FullSet;
+    typedef TemporalFeatureSet<(1u << 0) | (1u << 2) | (1u << 7) | (1u << 25)> PrunedSet;
+    float out[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+    double start;
+    float acc;
+
+    // Chaque appel écrit son propre bloc, entièrement lu : aucun n'est éliminé
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        FullSet::compute(window, WINDOW_SIZE, out);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            FullSet::compute(&window[seg * SEGMENT_SIZE], SEGMENT_SIZE, &out[(1 + seg) * FullSet::NumFeatures]);
+        acc = 0;
+        for (int i = 0; i < FullSet::NumFeatures * (1 + NUM_SEGMENTS); i++)
+            acc += out[i];
+        bench_sink = acc;
+    }
+    printResult("26 features (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        PrunedSet::compute(window, WINDOW_SIZE, out);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            PrunedSet::compute(&window[seg * SEGMENT_SIZE], SEGMENT_SIZE, &out[(1 + seg) * PrunedSet::NumFeatures]);
+        acc = 0;
+        for (int i = 0; i < PrunedSet::NumFeatures * (1 + NUM_SEGMENTS); i++)
+            acc += out[i];
+        bench_sink = acc;
+    }
+    printResult("4 features (fenetre + 7 seg)", benchMicros() - start, BENCH_ITERATIONS);
+
+    TEST_PASS();
+}
+
+// Noyaux log / sqrt rapides contre libm, et écart sur les features (fenêtre + 7 seg)
+void bench_fast_math(void)
+{
+    const int samples = 8 * WINDOW_SIZE;
+    double start;
+    float acc;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        acc = 0;
+        for (int i = 0; i < samples; i++)
+        {
+            float p = std::abs(bench_signal[i % (4 * WINDOW_SIZE)]) + 1e-8f;
+            acc += p * std::log(p);
+        }
+        bench_sink = acc;
+    }
+    printResult("entropie libm (8 x 178)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 10; it++)
+    {
+        acc = 0;
+        for (int i = 0; i < samples; i++)
+        {
+            float p = std::abs(bench_signal[i % (4 * WINDOW_SIZE)]) + 1e-8f;
+            acc += p * fastLog(p);
+        }
+        bench_sink = acc;
+    }
+    printResult("entropie fastLog (8 x 178)", benchMicros() - start, BENCH_ITERATIONS / 10);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        acc = 0;
+        for (int i = 0; i < 3 * (1 + NUM_SEGMENTS); i++)
+            acc += std::sqrt(std::abs(bench_signal[(it + i) % (4 * WINDOW_SIZE)]));
+        bench_sink = acc;
+    }
+    printResult("sqrt libm (x24)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        acc = 0;
+        for (int i = 0; i < 3 * (1 + NUM_SEGMENTS); i++)
+            acc += fastSqrt(std::abs(bench_signal[(it + i) % (4 * WINDOW_SIZE)]));
+        bench_sink = acc;
+    }
+    printResult("fastSqrt (x24)", benchMicros() - start, BENCH_ITERATIONS);
+
+    // Rapport de précision : features eegLog / eegSqrt contre libm (double)
+    double max_entropy = 0;
+    double max_std = 0;
+    double max_rms = 0;
+    double max_std_diff = 0;
+    for (int offset = 0; offset < 3 * WINDOW_SIZE; offset += 7)
+    {
+        for (int seg = 0; seg <= NUM_SEGMENTS; seg++)
+        {
+            const float *data = &bench_signal[offset + (seg == 0 ? 0 : (seg - 1) * SEGMENT_SIZE)];
+            int length = seg == 0 ? WINDOW_SIZE : SEGMENT_SIZE;
+            SegmentStats stats;
+            float out[NUM_TEMPORAL_FEATURES];
+            computeSegmentStats(data, length, stats);
+            writeTemporalFeatures(stats, out);
+
+            double entropy = 0;
+            for (int i = 0; i < length; i++)
+            {
+                double p = std::abs(data[i]) + 1e-8;
+                entropy -= p * std::log(p);
+            }
+            double std_val = std::sqrt((double)stats.m2 / length);
+            double rms = std::sqrt((double)stats.sum_sq / length);
+            double std_diff = std::sqrt((double)stats.abs_diff_dev_sq / (length - 1));
+
+            max_entropy = std::max(max_entropy, std::abs(out[12] - entropy) / std::abs(entropy));
+            max_std = std::max(max_std, std::abs(out[2] - std_val) / std_val);
+            max_rms = std::max(max_rms, std::abs(out[7] - rms) / rms);
+            max_std_diff = std::max(max_std_diff, std::abs(out[14] - std_diff) / std_diff);
+        }
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "  EEG_FAST_MATH=%d, ecart relatif max contre libm :", EEG_FAST_MATH);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "    entropie %.2e, std %.2e, rms %.2e, std_diff %.2e",
+             max_entropy, max_std, max_rms, max_std_diff);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_THAN(1e-5, max_entropy);
+    TEST_ASSERT_LESS_THAN(1e-6, std::max(max_std, std::max(max_rms, max_std_diff)));
+}
+
+// Émission vers le tenseur d'entrée : scaler + copie float contre int8 fusionné
+void bench_quantized_emission(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static float input_f[NUM_FEATURES];
+    static int8_t input_q[NUM_FEATURES];
+    double start;
+
+    preprocessor.begin();
+    for (int i = 0; i < 2 * WINDOW_SIZE; i++)
+        preprocessor.addSample(512 + (int)bench_signal[i]);
+    preprocessor.extractFeatures();
+    preprocessor.setInputQuantization(0.05f, -3);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        preprocessor.normalizeFeatures(input_f, NUM_FEATURES);
+        bench_sink = input_f[it % NUM_FEATURES];
+    }
+    printResult("scaler float (194)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        preprocessor.quantizeFeatures(input_q);
+        bench_sink = input_q[it % NUM_FEATURES];
+    }
+    printResult("scaler + quantif. int8 fusionnes (194)", benchMicros() - start, BENCH_ITERATIONS);
+
+    TEST_PASS();
+}
+
+// Fenêtre + 7 segments : deux parcours contre fusion des statistiques des segments
+void bench_moment_merge(void)
+{
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL> FullSet;
+    float out[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+    double start;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        FullSet::compute(window, WINDOW_SIZE, out);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            FullSet::compute(&window[seg * SEGMENT_SIZE], SEGMENT_SIZE, &out[(1 + seg) * NUM_TEMPORAL_FEATURES]);
+        bench_sink = out[0];
+    }
+    printResult("fenetre + segments (2 parcours)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        FullSet::computeWindow(&bench_signal[it % WINDOW_SIZE], out);
+        bench_sink = out[0];
+    }
+    printResult("segments + fusion (computeWindow)", benchMicros() - start, BENCH_ITERATIONS);
+
+    TEST_PASS();
+}
+
+// Groupe non linéaire (Hjorth, longueur de ligne, Teager–Kaiser) : dans la
+// passe fusionnée contre une passe dédiée après les 26 features
+void bench_nonlinear_features(void)
+{
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL> FullSet;
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_EXTENDED> ExtendedSet;
+    float out[TEMPORAL_FEATURE_TABLE_SIZE * (1 + NUM_SEGMENTS)];
+    double start;
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        FullSet::computeWindow(&bench_signal[it % WINDOW_SIZE], out);
+        bench_sink = out[0];
+    }
+    printResult("26 features (computeWindow)", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        const float *window = &bench_signal[it % WINDOW_SIZE];
+        FullSet::computeWindow(window, out);
+        for (int seg = -1; seg < NUM_SEGMENTS; seg++)
+        {
+            const float *data = seg < 0 ? window : &window[seg * SEGMENT_SIZE];
+            int length = seg < 0 ? WINDOW_SIZE : SEGMENT_SIZE;
+            float diff_power = 0;
+            float diff2_power = 0;
+            float teager = 0;
+            for (int i = 1; i < length; i++)
+            {
+                float diff = data[i] - data[i - 1];
+                diff_power += diff * diff;
+                if (i < length - 1)
+                {
+                    float diff2 = data[i + 1] - 2 * data[i] + data[i - 1];
+                    diff2_power += diff2 * diff2;
+                    teager += data[i] * data[i] - data[i - 1] * data[i + 1];
+                }
+            }
+            bench_sink = diff_power + diff2_power + teager;
+        }
+    }
+    printResult("26 features + passe non lineaire", benchMicros() - start, BENCH_ITERATIONS);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS; it++)
+    {
+        ExtendedSet::computeWindow(&bench_signal[it % WINDOW_SIZE], out);
+        bench_sink = out[0];
+    }
+    printResult("31 features (passe fusionnee)", benchMicros() - start, BENCH_ITERATIONS);
+
+    TEST_PASS();
+}
+
+// 1 s à 1000 Hz → 178 Hz : phases de sortie seules contre filtrage à la cadence d'entrée
+// SampEn par énumération complète des paires (référence)
+static float naiveSampleEntropy(const float *data, float tolerance)
+{
+    const int templates = WINDOW_SIZE - COMPLEXITY_EMBEDDING;
+    long matches_m = 0;
+    long matches_m1 = 0;
+    for (int i = 0; i < templates; i++)
+    {
+        for (int j = i + 1; j < templates; j++)
+        {
+            if (std::abs(data[i] - data[j]) > tolerance || std::abs(data[i + 1] - data[j + 1]) > tolerance)
+                continue;
+            matches_m++;
+            if (std::abs(data[i + 2] - data[j + 2]) <= tolerance)
+                matches_m1++;
+        }
+    }
+    return matches_m1 > 0 ? std::log((float)matches_m / matches_m1) : 0.0f;
+}
+
+void bench_complexity(void)
+{
+    const int iterations = BENCH_ITERATIONS / 10;
+    static float flat[WINDOW_SIZE];
+    float out[NUM_COMPLEXITY_FEATURES];
+    EntropyMatchCounts counts;
+    char line[112];
+    double start;
+
+    float tolerance = COMPLEXITY_TOLERANCE * 40.0f / std::sqrt(2.0f);
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        flat[i] = 12.5f;
+
+    start = benchMicros();
+    for (int it = 0; it < iterations; it++)
+        bench_sink = naiveSampleEntropy(&bench_signal[it % WINDOW_SIZE], tolerance);
+    printResult("SampEn naif (toutes les paires)", benchMicros() - start, iterations);
+
+    start = benchMicros();
+    for (int it = 0; it < iterations; it++)
+    {
+        countEntropyMatches(&bench_signal[it % WINDOW_SIZE], WINDOW_SIZE, tolerance, counts);
+        bench_sink = (float)counts.matches_m1;
+    }
+    printResult("SampEn + ApEn (tri)", benchMicros() - start, iterations);
+    snprintf(line, sizeof(line), "  paires candidates: %ld / %d", counts.candidates, COMPLEXITY_MAX_PAIRS);
+    TEST_MESSAGE(line);
+
+    // Pire cas : toutes les paires candidates
+    start = benchMicros();
+    for (int it = 0; it < iterations; it++)
+    {
+        countEntropyMatches(flat, WINDOW_SIZE, tolerance, counts);
+        bench_sink = (float)counts.matches_m1;
+    }
+    printResult("SampEn + ApEn (tri, pire cas)", benchMicros() - start, iterations);
+
+    start = benchMicros();
+    for (int it = 0; it < iterations; it++)
+    {
+        computeComplexityFeatures(&bench_signal[it % WINDOW_SIZE], out);
+        bench_sink = out[3];
+    }
+    printResult("4 features de complexite", benchMicros() - start, iterations);
+
+    TEST_PASS();
+}
+
+void bench_resampler(void)
+{
+    static PolyphaseResampler<1000> resampler;
+    static float in[1000];
+    static float out[PolyphaseResampler<1000>::maxOutput(1000)];
+    static float history[2 * RESAMPLER_TAPS_PER_PHASE];
+    static float fir[RESAMPLER_TAPS_PER_PHASE];
+    double start;
+
+    for (int i = 0; i < 1000; i++)
+        in[i] = bench_signal[i % (4 * WINDOW_SIZE)];
+    for (int k = 0; k < RESAMPLER_TAPS_PER_PHASE; k++)
+        fir[k] = 1.0f / RESAMPLER_TAPS_PER_PHASE;
+
+    // FIR de même longueur évalué à chaque échantillon d'entrée
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 100; it++)
+    {
+        int write_index = 0;
+        float sum = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            history[write_index] = in[i];
+            history[write_index + RESAMPLER_TAPS_PER_PHASE] = in[i];
+            write_index = (write_index + 1) % RESAMPLER_TAPS_PER_PHASE;
+            sum += dspDotProduct(fir, &history[write_index], RESAMPLER_TAPS_PER_PHASE);
+        }
+        bench_sink = sum;
+    }
+    printResult("FIR a 1000 Hz (1 s)", benchMicros() - start, BENCH_ITERATIONS / 100);
+
+    start = benchMicros();
+    for (int it = 0; it < BENCH_ITERATIONS / 100; it++)
+    {
+        int produced = resampler.process(in, 1000, out);
+        bench_sink = out[produced - 1];
+    }
+    printResult("polyphase 1000 -> 178 Hz (1 s)", benchMicros() - start, BENCH_ITERATIONS / 100);
+
+    TEST_PASS();
+}
+
+static void runBenchmarks()
+{
+    fillSignal();
+    UNITY_BEGIN();
+    RUN_TEST(bench_median);
+    RUN_TEST(bench_bandpass);
+    RUN_TEST(bench_fixed_point);
+    RUN_TEST(bench_dsp_kernels);
+    RUN_TEST(bench_spectral);
+    RUN_TEST(bench_wavelet);
+    RUN_TEST(bench_multichannel);
+    RUN_TEST(bench_feature_set);
+    RUN_TEST(bench_fast_math);
+    RUN_TEST(bench_quantized_emission);
+    RUN_TEST(bench_moment_merge);
+    RUN_TEST(bench_nonlinear_features);
+    RUN_TEST(bench_complexity);
+    RUN_TEST(bench_resampler);
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    delay(2000);
+    runBenchmarks();
+}
+
+void loop()
+{
+}
+#else
+int main(void)
+{
+    runBenchmarks();
+    return 0;
+}
+#endif
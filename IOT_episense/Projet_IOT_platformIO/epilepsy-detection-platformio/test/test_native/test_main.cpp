@@ -0,0 +1,2363 @@
+/**
+ * @file test_main.cpp
+ * @brief Tests hôte (env:native) des noyaux DSP / features EEG
+ *
+ * Ce fichier teste, sans carte ni Arduino:
+ * - Le noyau fusionné de statistiques contre l'implémentation historique
+ * - Les fenêtres glissantes (hop configurable) du buffer circulaire miroir
+ * - Le moteur incrémental contre le recalcul exact (dérive bornée)
+ * - La médiane par sélection et la médiane glissante contre le tri complet
+ * - La cascade de biquads (stabilité, API bloc, équivalence du passe-bas)
+ * - L'ingestion par blocs addSamples() contre addSample()
+ * - La chaîne en virgule fixe contre la référence float (bornes d'erreur)
+ * - Les primitives DSP de référence (oracle du backend ESP-DSP)
+ * - La FFT réelle et les features spectrales (layout de features v2)
+ * - Le banc de Goertzel glissant contre une DFT de la fenêtre
+ * - La DWT par lifting (Haar directe, moments nuls, localisation des bandes)
+ * - SampEn / ApEn par tri contre l'énumération complète, dimensions fractales
+ * - Le préprocesseur multi-voies contre le préprocesseur mono-voie
+ * - Le descripteur de features (sous-ensembles, doublons, statistiques élaguées)
+ * - Les features non linéaires (Hjorth, Teager–Kaiser) dans la passe fusionnée
+ * - Les noyaux log / sqrt rapides contre libm (bornes d'erreur documentées)
+ */
+
+#include <unity.h>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <complex>
+
+#include "BITalinoEEG_Features.h"
+#include "BITalinoEEG_FeatureSet.h"
+#include "BITalinoEEG_Incremental.h"
+#include "BITalinoEEG_Median.h"
+#include "BITalinoEEG_Filters.h"
+#include "BITalinoEEG_FilterDesign.h"
+#include "BITalinoEEG_Fixed.h"
+#include "BITalinoEEG_DSP.h"
+#include "BITalinoEEG_Spectral.h"
+#include "BITalinoEEG_Goertzel.h"
+#include "BITalinoEEG_Wavelet.h"
+#include "BITalinoEEG_Complexity.h"
+#include "BITalinoEEG_Preprocessor.h"
+#include "BITalinoEEG_MultiChannel.h"
+#include "BITalinoEEG_Moments.h"
+#include "BITalinoEEG_Resampler.h"
+#include "BITalinoEEG_Frame.h"
+#include "scaler_params.h"
+
+// ---------------------------------------------------------------------------
+// Implémentation historique (une boucle par statistique), servant d'oracle.
+// Elle utilise les mêmes primitives eegLog / eegSqrt que la bibliothèque :
+// l'écart à libm est couvert séparément (test_fast_math_error_bounds).
+// ---------------------------------------------------------------------------
+
+static float refMean(const float *data, int length)
+{
+    float sum = 0;
+    for (int i = 0; i < length; i++)
+        sum += data[i];
+    return sum / length;
+}
+
+static float refMedian(const float *data, int length)
+{
+    float temp[WINDOW_SIZE];
+    memcpy(temp, data, length * sizeof(float));
+    std::sort(temp, temp + length);
+    if (length % 2 == 0)
+        return (temp[length / 2 - 1] + temp[length / 2]) / 2.0f;
+    return temp[length / 2];
+}
+
+static float refVariance(const float *data, int length, float mean)
+{
+    float sum = 0;
+    for (int i = 0; i < length; i++)
+    {
+        float diff = data[i] - mean;
+        sum += diff * diff;
+    }
+    return sum / length;
+}
+
+static float refMin(const float *data, int length)
+{
+    float min_val = data[0];
+    for (int i = 1; i < length; i++)
+        if (data[i] < min_val)
+            min_val = data[i];
+    return min_val;
+}
+
+static float refMax(const float *data, int length)
+{
+    float max_val = data[0];
+    for (int i = 1; i < length; i++)
+        if (data[i] > max_val)
+            max_val = data[i];
+    return max_val;
+}
+
+static float refEnergy(const float *data, int length)
+{
+    float sum = 0;
+    for (int i = 0; i < length; i++)
+        sum += data[i] * data[i];
+    return sum;
+}
+
+static float refMoment(const float *data, int length, float mean, float std, int order)
+{
+    if (std < 1e-8)
+        return 0.0f;
+    float sum = 0;
+    for (int i = 0; i < length; i++)
+    {
+        float z = (data[i] - mean) / std;
+        sum += order == 3 ? z * z * z : z * z * z * z;
+    }
+    return order == 3 ? sum / length : (sum / length) - 3.0f;
+}
+
+static int refZeroCrossings(const float *data, int length)
+{
+    int count = 0;
+    for (int i = 1; i < length; i++)
+        if ((data[i - 1] >= 0 && data[i] < 0) || (data[i - 1] < 0 && data[i] >= 0))
+            count++;
+    return count;
+}
+
+static float refEntropy(const float *data, int length)
+{
+    float sum = 0;
+    for (int i = 0; i < length; i++)
+    {
+        float p = std::abs(data[i]) + 1e-8;
+        sum += p * eegLog(p);
+    }
+    return -sum;
+}
+
+static float refMeanDiff(const float *data, int length)
+{
+    float sum = 0;
+    for (int i = 1; i < length; i++)
+        sum += std::abs(data[i] - data[i - 1]);
+    return sum / (length - 1);
+}
+
+static float refStdDiff(const float *data, int length)
+{
+    float mean_diff = refMeanDiff(data, length);
+    float sum = 0;
+    for (int i = 1; i < length; i++)
+    {
+        float diff = std::abs(data[i] - data[i - 1]) - mean_diff;
+        sum += diff * diff;
+    }
+    return eegSqrt(sum / (length - 1));
+}
+
+static void refTemporalFeatures(const float *segment, int length, float *out)
+{
+    float mean_val = refMean(segment, length);
+    float std_val = eegSqrt(refVariance(segment, length, mean_val));
+    float max_val = refMax(segment, length);
+    float min_val = refMin(segment, length);
+
+    out[0] = mean_val;
+    out[1] = refMedian(segment, length);
+    out[2] = std_val;
+    out[3] = refVariance(segment, length, mean_val);
+    out[4] = min_val;
+    out[5] = max_val;
+    out[6] = max_val - min_val;
+    out[7] = eegSqrt(refEnergy(segment, length) / length);
+    out[8] = refEnergy(segment, length);
+    out[9] = refMoment(segment, length, mean_val, std_val, 3);
+    out[10] = refMoment(segment, length, mean_val, std_val, 4);
+    out[11] = refZeroCrossings(segment, length);
+    out[12] = refEntropy(segment, length);
+    out[13] = refMeanDiff(segment, length);
+    out[14] = refStdDiff(segment, length);
+    out[15] = max_val - min_val;
+    out[16] = std_val / (mean_val + 1e-8);
+    out[17] = max_val / (min_val + 1e-8);
+    out[18] = std::abs(mean_val);
+    out[19] = std_val * std_val;
+    out[20] = eegSqrt(refEnergy(segment, length) / length) / (std::abs(mean_val) + 1e-8);
+    out[21] = refEnergy(segment, length) / length;
+    out[22] = (max_val - min_val) / 2.0f;
+    out[23] = std::abs(refMeanDiff(segment, length));
+    out[24] = refStdDiff(segment, length) / (std_val + 1e-8);
+    out[25] = refZeroCrossings(segment, length) / (float)length;
+}
+
+// ---------------------------------------------------------------------------
+// Signaux de test
+// ---------------------------------------------------------------------------
+
+static void generateEEGLikeSignal(float *out, int length, unsigned seed)
+{
+    srand(seed);
+    for (int i = 0; i < length; i++)
+    {
+        float t = i / (float)SAMPLE_RATE;
+        float noise = (rand() % 2001 - 1000) / 1000.0f;
+        out[i] = 40.0f * std::sin(2 * M_PI * 8.0f * t) +
+                 15.0f * std::sin(2 * M_PI * 3.0f * t + 0.7f) +
+                 10.0f * noise + (seed % 7) - 3.0f;
+    }
+}
+
+static void assertFeaturesClose(const float *expected, const float *actual, int count, float rel_tol)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float tol = rel_tol * std::max(1.0f, std::abs(expected[i]));
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tol, expected[i], actual[i], "feature");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_fused_kernel_matches_reference_full_window(void)
+{
+    float signal[WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES];
+
+    for (unsigned seed = 1; seed <= 20; seed++)
+    {
+        generateEEGLikeSignal(signal, WINDOW_SIZE, seed);
+
+        refTemporalFeatures(signal, WINDOW_SIZE, expected);
+
+        SegmentStats stats;
+        computeSegmentStats(signal, WINDOW_SIZE, stats);
+        writeTemporalFeatures(stats, actual);
+
+        assertFeaturesClose(expected, actual, NUM_TEMPORAL_FEATURES, 1e-5f);
+    }
+}
+
+void test_fused_kernel_matches_reference_segments(void)
+{
+    float signal[WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES];
+    int segment_size = WINDOW_SIZE / NUM_SEGMENTS;
+
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 42);
+
+    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+    {
+        const float *segment = &signal[seg * segment_size];
+
+        refTemporalFeatures(segment, segment_size, expected);
+
+        SegmentStats stats;
+        computeSegmentStats(segment, segment_size, stats);
+        writeTemporalFeatures(stats, actual);
+
+        assertFeaturesClose(expected, actual, NUM_TEMPORAL_FEATURES, 1e-5f);
+    }
+}
+
+void test_fused_kernel_bit_exact_except_higher_moments(void)
+{
+    float signal[WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES];
+
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 7);
+    refTemporalFeatures(signal, WINDOW_SIZE, expected);
+
+    SegmentStats stats;
+    computeSegmentStats(signal, WINDOW_SIZE, stats);
+    writeTemporalFeatures(stats, actual);
+
+    for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+    {
+        if (i == 9 || i == 10)
+            continue;
+        TEST_ASSERT_EQUAL_MEMORY(&expected[i], &actual[i], sizeof(float));
+    }
+}
+
+void test_fused_kernel_constant_signal(void)
+{
+    float signal[25];
+    for (int i = 0; i < 25; i++)
+        signal[i] = 5.0f;
+
+    SegmentStats stats;
+    float actual[NUM_TEMPORAL_FEATURES];
+    computeSegmentStats(signal, 25, stats);
+    writeTemporalFeatures(stats, actual);
+
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, actual[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, actual[2]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, actual[9]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, actual[10]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, actual[11]);
+}
+
+void test_ring_buffer_hop_cadence(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    preprocessor.begin();
+    preprocessor.setOverlapPercentage(75);
+
+    int hop = preprocessor.getHopSize();
+    TEST_ASSERT_EQUAL_INT(WINDOW_SIZE - WINDOW_SIZE * 75 / 100, hop);
+
+    int windows = 0;
+    for (int n = 1; n <= WINDOW_SIZE + 10 * hop; n++)
+    {
+        bool ready = preprocessor.addSample(512);
+        bool expected = n >= WINDOW_SIZE && (n - WINDOW_SIZE) % hop == 0;
+        TEST_ASSERT_EQUAL_INT(expected, ready);
+        windows += ready;
+    }
+    TEST_ASSERT_EQUAL_INT(11, windows);
+}
+
+void test_ring_buffer_window_is_contiguous_and_ordered(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    preprocessor.begin();
+    preprocessor.setHopSize(40);
+
+    int total = 3 * WINDOW_SIZE + 17;
+    for (int n = 0; n < total; n++)
+    {
+        preprocessor.addSample(n % 1024);
+    }
+
+    const float *window = preprocessor.getRawWindow();
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        int adc = (total - WINDOW_SIZE + i) % 1024;
+        TEST_ASSERT_EQUAL_FLOAT(preprocessor.convertADCtoMicrovolts(adc), window[i]);
+    }
+}
+
+// Indices mal conditionnés (division par une moyenne ou un min proche de 0)
+static bool isRatioFeature(int i)
+{
+    return i == 16 || i == 17 || i == 20;
+}
+
+static void assertIncrementalMatchesBatch(const float *window, const IncrementalFeatureEngine &engine, float rel_tol)
+{
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES];
+    SegmentStats stats;
+
+    for (int seg = -1; seg < NUM_SEGMENTS; seg++)
+    {
+        const float *data = seg < 0 ? window : &window[seg * SEGMENT_SIZE];
+        int length = seg < 0 ? WINDOW_SIZE : SEGMENT_SIZE;
+
+        computeSegmentStats(data, length, stats);
+        writeTemporalFeatures(stats, expected);
+
+        if (seg < 0)
+            engine.getWindowStats(stats);
+        else
+            engine.getSegmentStats(seg, stats);
+        writeTemporalFeatures(stats, actual);
+
+        for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+        {
+            if (isRatioFeature(i))
+                continue;
+            float scale = (i == 0 || i == 18) ? expected[2] : std::abs(expected[i]);
+            TEST_ASSERT_FLOAT_WITHIN_MESSAGE(rel_tol * std::max(1.0f, scale), expected[i], actual[i], "incremental");
+        }
+    }
+}
+
+void test_incremental_engine_tracks_batch_without_reanchor(void)
+{
+    static IncrementalFeatureEngine engine;
+    static float stream[20 * WINDOW_SIZE];
+    float ring[2 * WINDOW_SIZE] = {0};
+    int write_index = 0;
+
+    int total = 20 * WINDOW_SIZE;
+    generateEEGLikeSignal(stream, total, 11);
+
+    engine.reset();
+    for (int n = 0; n < total; n++)
+    {
+        float leaving = ring[write_index];
+        ring[write_index] = stream[n];
+        ring[write_index + WINDOW_SIZE] = stream[n];
+        if (++write_index == WINDOW_SIZE)
+            write_index = 0;
+
+        const float *window = &ring[write_index];
+        engine.update(window, leaving);
+
+        if (n == WINDOW_SIZE - 1)
+            engine.anchor(window);
+
+        if (n >= WINDOW_SIZE && n % 7 == 0)
+            assertIncrementalMatchesBatch(window, engine, 1e-3f);
+    }
+}
+
+void test_selection_median_matches_sort(void)
+{
+    float signal[WINDOW_SIZE];
+
+    for (unsigned seed = 1; seed <= 20; seed++)
+    {
+        generateEEGLikeSignal(signal, WINDOW_SIZE, seed);
+        for (int length = 2; length <= WINDOW_SIZE; length += 11)
+        {
+            float expected = refMedian(signal, length);
+            float actual = calculateMedian(signal, length);
+            TEST_ASSERT_EQUAL_MEMORY(&expected, &actual, sizeof(float));
+        }
+    }
+}
+
+template <int Length>
+static void checkSlidingMedian(unsigned seed)
+{
+    static SlidingMedian<Length> median;
+    static float stream[4 * WINDOW_SIZE];
+    int total = 4 * WINDOW_SIZE;
+
+    generateEEGLikeSignal(stream, total, seed);
+    // Valeurs répétées pour exercer les égalités (+0.0f évite les zéros négatifs)
+    for (int i = 0; i < total; i += 5)
+        stream[i] = std::round(stream[i] / 10.0f) * 10.0f + 0.0f;
+
+    median.clear();
+    for (int n = 0; n < total; n++)
+    {
+        median.push(stream[n]);
+        int count = std::min(n + 1, Length);
+        float expected = refMedian(&stream[n + 1 - count], count);
+        float actual = median.median();
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &actual, sizeof(float));
+    }
+}
+
+void test_sliding_median_matches_sort(void)
+{
+    checkSlidingMedian<SEGMENT_SIZE>(3);
+    checkSlidingMedian<WINDOW_SIZE>(5);
+
+    // Copie indépendante de l'original (aucun pointeur vers son stockage)
+    static SlidingMedian<SEGMENT_SIZE> original;
+    static float stream[2 * SEGMENT_SIZE];
+    generateEEGLikeSignal(stream, 2 * SEGMENT_SIZE, 7);
+    original.clear();
+    for (int n = 0; n < SEGMENT_SIZE; n++)
+        original.push(stream[n]);
+
+    static SlidingMedian<SEGMENT_SIZE> copy;
+    copy = original;
+    original.clear();
+    for (int n = SEGMENT_SIZE; n < 2 * SEGMENT_SIZE; n++)
+    {
+        copy.push(stream[n]);
+        original.push(-1000.0f);
+        float expected = refMedian(&stream[n + 1 - SEGMENT_SIZE], SEGMENT_SIZE);
+        float actual = copy.median();
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &actual, sizeof(float));
+    }
+}
+
+void test_biquad_block_matches_per_sample(void)
+{
+    static float stream[4 * WINDOW_SIZE];
+    static float block_out[4 * WINDOW_SIZE];
+    int total = 4 * WINDOW_SIZE;
+    generateEEGLikeSignal(stream, total, 9);
+
+    BiquadCascade<BANDPASS_NUM_SECTIONS> per_sample;
+    BiquadCascade<BANDPASS_NUM_SECTIONS> block;
+
+    // Blocs de tailles variées pour vérifier la continuité de l'état
+    int offset = 0;
+    int sizes[] = {1, 7, 32, 100, 3};
+    for (int k = 0; offset < total; k = (k + 1) % 5)
+    {
+        int n = std::min(sizes[k], total - offset);
+        block.processBlock(&stream[offset], &block_out[offset], n);
+        offset += n;
+    }
+
+    for (int i = 0; i < total; i++)
+    {
+        float expected = per_sample.process(stream[i]);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &block_out[i], sizeof(float));
+    }
+}
+
+void test_bandpass_is_stable_and_rejects_dc(void)
+{
+    BiquadCascade<BANDPASS_NUM_SECTIONS> bandpass;
+
+    // Échelon de 1000 µV (décalage DC de l'ADC) pendant 60 s
+    float y = 0;
+    for (int i = 0; i < 60 * SAMPLE_RATE; i++)
+    {
+        y = bandpass.process(1000.0f);
+        TEST_ASSERT_TRUE(std::isfinite(y));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 0.0f, y);
+}
+
+// Module de la réponse d'une cascade de sections à f Hz
+static double cascadeMagnitude(const BiquadCoefficients *sections, int count, double f, double fs)
+{
+    std::complex<double> z1 = std::polar(1.0, -2 * M_PI * f / fs);
+    std::complex<double> z2 = z1 * z1;
+    std::complex<double> h = 1.0;
+    for (int s = 0; s < count; s++)
+    {
+        const BiquadCoefficients &c = sections[s];
+        h *= ((double)c.b0 + (double)c.b1 * z1 + (double)c.b2 * z2) / (1.0 + (double)c.a1 * z1 + (double)c.a2 * z2);
+    }
+    return std::abs(h);
+}
+
+void test_filter_design_matches_legacy_bandpass(void)
+{
+    // Passe-haut : coefficients de l'ancienne table
+    const BiquadCoefficients legacy_highpass[2] = {
+        {0.993214176f, -1.986428351f, 0.993214176f, -1.986273649f, 0.986583053f},
+        {0.983879896f, -1.967759792f, 0.983879896f, -1.967606544f, 0.967913040f},
+    };
+    for (int s = 0; s < 2; s++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, legacy_highpass[s].b0, BANDPASS_SECTIONS[s].b0);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, legacy_highpass[s].b1, BANDPASS_SECTIONS[s].b1);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, legacy_highpass[s].b2, BANDPASS_SECTIONS[s].b2);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, legacy_highpass[s].a1, BANDPASS_SECTIONS[s].a1);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, legacy_highpass[s].a2, BANDPASS_SECTIONS[s].a2);
+    }
+
+    // Passe-bas : réponse de l'ancien filtre d'ordre 4 (forme directe) à 0.3 dB près
+    const double b[5] = {0.0201, 0.0804, 0.1206, 0.0804, 0.0201};
+    const double a[5] = {1.0, -1.9644, 1.7469, -0.7498, 0.1327};
+    for (int f = 1; f <= 45; f++)
+    {
+        std::complex<double> num = 0, den = 0;
+        for (int i = 0; i < 5; i++)
+        {
+            std::complex<double> zi = std::polar(1.0, -2 * M_PI * f * i / SAMPLE_RATE);
+            num += b[i] * zi;
+            den += a[i] * zi;
+        }
+        double legacy_db = 20 * std::log10(std::abs(num / den));
+        double designed_db = 20 * std::log10(cascadeMagnitude(&BANDPASS_SECTIONS[2], 2, f, SAMPLE_RATE));
+        TEST_ASSERT_FLOAT_WITHIN(0.3, legacy_db, designed_db);
+    }
+
+    // Réjecteur : nul à EEG_MAINS_FREQUENCY, transparent dans la bande EEG
+    const BiquadCoefficients &notch = BANDPASS_SECTIONS[BANDPASS_NUM_SECTIONS - 1];
+#if EEG_MAINS_FREQUENCY > 0
+    TEST_ASSERT_LESS_THAN(1e-3, cascadeMagnitude(&notch, 1, EEG_MAINS_FREQUENCY, SAMPLE_RATE));
+#endif
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 1.0, cascadeMagnitude(&notch, 1, 20.0, SAMPLE_RATE));
+
+    // Calcul à l'exécution : mêmes sections, réjecteur déplacé à 60 Hz
+    volatile int mains = EEG_MAINS_FREQUENCY;
+    BiquadSectionSet<BANDPASS_NUM_SECTIONS> runtime = designEEGBandpass(SAMPLE_RATE, mains);
+    TEST_ASSERT_EQUAL_MEMORY(BANDPASS_SECTIONS, runtime.section, sizeof(runtime.section));
+
+    mains = 60;
+    runtime = designEEGBandpass(SAMPLE_RATE, mains);
+    TEST_ASSERT_LESS_THAN(1e-3, cascadeMagnitude(runtime.section, BANDPASS_NUM_SECTIONS, 60.0, SAMPLE_RATE));
+
+    // Autre fréquence d'échantillonnage : gain de bande passante conservé
+    runtime = designEEGBandpass(1000.0, mains);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, EEG_BANDPASS_GAIN, cascadeMagnitude(runtime.section, BANDPASS_NUM_SECTIONS, 8.0, 1000.0));
+
+    for (double x = -10; x <= 10; x += 0.37)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-12, std::sin(x), designSin(x));
+        TEST_ASSERT_FLOAT_WITHIN(1e-12, std::cos(x), designCos(x));
+    }
+}
+
+// Ingestion complète d'un flux (addSamples() s'arrête à chaque fenêtre)
+static void ingestAll(BITalinoEEGPreprocessor &preprocessor, const int *adc, size_t count)
+{
+    while (count > 0)
+    {
+        size_t consumed = preprocessor.addSamples(adc, count);
+        adc += consumed;
+        count -= consumed;
+    }
+}
+
+static void checkBlockIngestion(bool incremental)
+{
+    static BITalinoEEGPreprocessor per_sample;
+    static BITalinoEEGPreprocessor block;
+    static int adc[6 * WINDOW_SIZE];
+    int total = 6 * WINDOW_SIZE;
+    const int hop = 30;
+
+    srand(21);
+    for (int i = 0; i < total; i++)
+        adc[i] = 512 + (int)(100 * std::sin(i * 0.3)) + rand() % 21 - 10;
+
+    per_sample.begin();
+    block.begin();
+    per_sample.setHopSize(hop);
+    block.setHopSize(hop);
+    per_sample.setIncrementalMode(incremental);
+    block.setIncrementalMode(incremental);
+
+    // Blocs de tailles variées, dont un bloc couvrant plusieurs fenêtres
+    int sizes[] = {1, 5, 64, 17, 250, 3};
+    int offset = 0;
+    int windows = 0;
+    for (int k = 0; offset < total; k = (k + 1) % 6)
+    {
+        int n = std::min(sizes[k], total - offset);
+        int windows_in_block = 0;
+
+        while (n > 0)
+        {
+            uint32_t sequence = block.getWindowSequence();
+            int consumed = (int)block.addSamples(&adc[offset], n);
+            TEST_ASSERT_GREATER_THAN(0, consumed);
+
+            bool window_sample = false;
+            for (int i = 0; i < consumed; i++)
+                window_sample = per_sample.addSample(adc[offset + i]);
+            offset += consumed;
+            n -= consumed;
+
+            TEST_ASSERT_EQUAL_UINT32(per_sample.getWindowSequence(), block.getWindowSequence());
+            TEST_ASSERT_EQUAL_MEMORY(per_sample.getWindow(), block.getWindow(), WINDOW_SIZE * sizeof(float));
+            TEST_ASSERT_EQUAL_MEMORY(per_sample.getRawWindow(), block.getRawWindow(), WINDOW_SIZE * sizeof(float));
+
+            if (block.getWindowSequence() != sequence)
+            {
+                // La fenêtre se termine sur le hop, sans échantillon en trop
+                TEST_ASSERT_EQUAL_UINT32(sequence + 1, block.getWindowSequence());
+                TEST_ASSERT_TRUE(window_sample);
+                TEST_ASSERT_EQUAL_INT(0, (offset - WINDOW_SIZE) % hop);
+                const float *raw = block.getRawWindow();
+                TEST_ASSERT_EQUAL_FLOAT(block.convertADCtoMicrovolts(adc[offset - WINDOW_SIZE]), raw[0]);
+                TEST_ASSERT_EQUAL_FLOAT(block.convertADCtoMicrovolts(adc[offset - 1]), raw[WINDOW_SIZE - 1]);
+
+                TEST_ASSERT_TRUE(block.extractFeatures());
+                TEST_ASSERT_TRUE(per_sample.extractFeatures());
+                TEST_ASSERT_EQUAL_MEMORY(per_sample.getFeatures(), block.getFeatures(),
+                                         per_sample.getFeatureCount() * sizeof(float));
+                windows++;
+                windows_in_block++;
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL_INT(0, n);
+            }
+        }
+
+        if (sizes[k] == 250)
+            TEST_ASSERT_GREATER_THAN(1, windows_in_block);
+    }
+    TEST_ASSERT_EQUAL_INT(1 + (total - WINDOW_SIZE) / hop, windows);
+}
+
+void test_block_ingestion_matches_per_sample(void)
+{
+    checkBlockIngestion(false);
+    checkBlockIngestion(true);
+}
+
+void test_fixed_log2_accuracy(void)
+{
+    for (uint32_t v = 1; v < (1u << 24); v = v * 3 / 2 + 1)
+    {
+        float expected = std::log2((double)v);
+        float actual = fixedLog2(v) / 65536.0f;
+        TEST_ASSERT_FLOAT_WITHIN(2e-4f, expected, actual);
+    }
+}
+
+// Flux ADC 10 bits pseudo-EEG (offset, alpha, bruit)
+static void generateADCStream(int *adc, int length, unsigned seed)
+{
+    srand(seed);
+    for (int i = 0; i < length; i++)
+    {
+        float t = i / (float)SAMPLE_RATE;
+        adc[i] = 530 + (int)(20 * std::sin(2 * M_PI * 8.0f * t) + 8 * std::sin(2 * M_PI * 2.5f * t)) +
+                 rand() % 7 - 3;
+    }
+}
+
+void test_fixed_bandpass_error_bound(void)
+{
+    static int adc[30 * SAMPLE_RATE];
+    int total = 30 * SAMPLE_RATE;
+    generateADCStream(adc, total, 17);
+
+    FixedBiquadCascade<BANDPASS_NUM_SECTIONS> fixed;
+    BiquadCascade<BANDPASS_NUM_SECTIONS> single;
+
+    // Référence double précision (mêmes coefficients, DF-II transposée)
+    double z1[BANDPASS_NUM_SECTIONS] = {0};
+    double z2[BANDPASS_NUM_SECTIONS] = {0};
+
+    double fixed_error = 0;
+    double float_error = 0;
+    for (int n = 0; n < total; n++)
+    {
+        double x = (adc[n] - 512) * 3.22265625;
+        for (int s = 0; s < BANDPASS_NUM_SECTIONS; s++)
+        {
+            const BiquadCoefficients &c = BANDPASS_SECTIONS[s];
+            double y = c.b0 * x + z1[s];
+            z1[s] = c.b1 * x - c.a1 * y + z2[s];
+            z2[s] = c.b2 * x - c.a2 * y;
+            x = y;
+        }
+
+        float y_fixed = fixedToMicrovolts(fixed.process(adcToFixed(adc[n])));
+        float y_float = single.process((adc[n] - 512) * 3.22265625f);
+        fixed_error = std::max(fixed_error, std::abs(y_fixed - x));
+        float_error = std::max(float_error, std::abs(y_float - x));
+    }
+
+    // Quantification Q8 (1/256 µV) amplifiée par les pôles du passe-haut
+    TEST_ASSERT_LESS_THAN(0.01, fixed_error);
+    TEST_ASSERT_LESS_THAN(0.01, float_error);
+}
+
+void test_fixed_features_error_bound(void)
+{
+    static int adc[8 * WINDOW_SIZE];
+    static eeg_fixed_t filtered_q[8 * WINDOW_SIZE];
+    float window[WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES];
+
+    for (unsigned seed = 1; seed <= 5; seed++)
+    {
+        generateADCStream(adc, 8 * WINDOW_SIZE, seed);
+        FixedBiquadCascade<BANDPASS_NUM_SECTIONS> fixed;
+        for (int n = 0; n < 8 * WINDOW_SIZE; n++)
+            filtered_q[n] = fixed.process(adcToFixed(adc[n]));
+
+        // Dernière fenêtre, mêmes échantillons pour les deux chaînes
+        const eeg_fixed_t *window_q = &filtered_q[7 * WINDOW_SIZE];
+        for (int i = 0; i < WINDOW_SIZE; i++)
+            window[i] = fixedToMicrovolts(window_q[i]);
+
+        for (int seg = -1; seg < NUM_SEGMENTS; seg++)
+        {
+            int offset = seg < 0 ? 0 : seg * SEGMENT_SIZE;
+            int length = seg < 0 ? WINDOW_SIZE : SEGMENT_SIZE;
+
+            SegmentStats stats;
+            computeSegmentStats(&window[offset], length, stats);
+            writeTemporalFeatures(stats, expected);
+
+            FixedSegmentStats fixed_stats;
+            computeFixedSegmentStats(&window_q[offset], length, fixed_stats);
+            fixedToSegmentStats(fixed_stats, stats);
+            writeTemporalFeatures(stats, actual);
+
+            for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+            {
+                if (isRatioFeature(i))
+                    continue;
+                float scale = (i == 0 || i == 18) ? expected[2] : std::abs(expected[i]);
+                TEST_ASSERT_FLOAT_WITHIN_MESSAGE(1e-3f * std::max(1.0f, scale), expected[i], actual[i], "fixed");
+            }
+        }
+    }
+}
+
+void test_dsp_reference_kernels(void)
+{
+    static float signal[4 * WINDOW_SIZE];
+    static float df2_out[4 * WINDOW_SIZE];
+    static float shifted[4 * WINDOW_SIZE];
+    int total = 4 * WINDOW_SIZE;
+    generateEEGLikeSignal(signal, total, 23);
+
+    double sum = 0;
+    double energy = 0;
+    for (int i = 0; i < total; i++)
+    {
+        sum += signal[i];
+        energy += (double)signal[i] * signal[i];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4 * total * 40, sum, dspSum(signal, total));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5 * energy, energy, dspDotProduct(signal, signal, total));
+
+    dspAddConstant(signal, shifted, total, -2.5f);
+    for (int i = 0; i < total; i++)
+        TEST_ASSERT_EQUAL_FLOAT(signal[i] - 2.5f, shifted[i]);
+
+    // Forme directe II (convention ESP-DSP) contre la cascade DF-II transposée
+    // sur les sections passe-bas, bien conditionnées
+    float state[2][2] = {{0, 0}, {0, 0}};
+    dspBiquad(signal, df2_out, total, BANDPASS_SECTIONS[2], state[0]);
+    dspBiquad(df2_out, df2_out, total, BANDPASS_SECTIONS[3], state[1]);
+
+    BiquadCascade<2> lowpass(&BANDPASS_SECTIONS[2]);
+    for (int i = 0; i < total; i++)
+    {
+        float expected = lowpass.process(signal[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::max(1.0f, std::abs(expected)), expected, df2_out[i]);
+    }
+}
+
+void test_real_fft_matches_dft(void)
+{
+    static float input[SPECTRAL_FFT_SIZE];
+    static float output[2 * SPECTRAL_NUM_BINS];
+    generateEEGLikeSignal(input, SPECTRAL_FFT_SIZE, 29);
+
+    spectralRealFFT(input, output);
+
+    for (int k = 0; k < SPECTRAL_NUM_BINS; k++)
+    {
+        double re = 0;
+        double im = 0;
+        for (int n = 0; n < SPECTRAL_FFT_SIZE; n++)
+        {
+            double angle = 2.0 * M_PI * k * n / SPECTRAL_FFT_SIZE;
+            re += input[n] * std::cos(angle);
+            im -= input[n] * std::sin(angle);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-2f, re, output[2 * k]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-2f, im, output[2 * k + 1]);
+    }
+}
+
+static void generateSine(float *out, float frequency, float amplitude)
+{
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        out[i] = amplitude * std::sin(2 * M_PI * frequency * i / SAMPLE_RATE);
+}
+
+void test_spectral_features_locate_band(void)
+{
+    float window[WINDOW_SIZE];
+    float spectral[NUM_SPECTRAL_FEATURES];
+    const float bin_width = (float)SAMPLE_RATE / SPECTRAL_FFT_SIZE;
+
+    // Alpha pur à 10 Hz, 40 µV : puissance A²/2 = 800 µV²
+    generateSine(window, 10.0f, 40.0f);
+    computeSpectralFeatures(window, spectral);
+
+    TEST_ASSERT_GREATER_THAN(0.95f, spectral[7]);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * 800.0f, 800.0f, spectral[10]);
+    TEST_ASSERT_FLOAT_WITHIN(bin_width, 10.0f, spectral[11]);
+    TEST_ASSERT_FLOAT_WITHIN(bin_width, 10.0f, spectral[12]);
+    TEST_ASSERT_LESS_THAN(0.5f, spectral[14]);
+
+    // Delta à 2 Hz : rapport de ralentissement élevé
+    generateSine(window, 2.0f, 40.0f);
+    computeSpectralFeatures(window, spectral);
+
+    TEST_ASSERT_GREATER_THAN(0.9f, spectral[5]);
+    TEST_ASSERT_GREATER_THAN(10.0f, spectral[15]);
+
+    // Bruit large bande : entropie proche de 1
+    srand(31);
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        window[i] = (rand() % 2001 - 1000) / 100.0f;
+    computeSpectralFeatures(window, spectral);
+
+    TEST_ASSERT_GREATER_THAN(0.85f, spectral[14]);
+    TEST_ASSERT_GREATER_THAN(spectral[12], spectral[13]);
+}
+
+void test_feature_layout_versions(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[3 * WINDOW_SIZE];
+    float spectral[NUM_SPECTRAL_FEATURES];
+
+    srand(37);
+    for (int i = 0; i < 3 * WINDOW_SIZE; i++)
+        adc[i] = 512 + (int)(30 * std::sin(i * 0.35)) + rand() % 11 - 5;
+
+    preprocessor.begin();
+    TEST_ASSERT_EQUAL_UINT(0, preprocessor.getFeatureGroups());
+    TEST_ASSERT_EQUAL_INT(NUM_TEMPORAL_LAYOUT_FEATURES, preprocessor.getFeatureCount());
+
+    preprocessor.setFeatureLayout(FEATURE_LAYOUT_SPECTRAL);
+    TEST_ASSERT_EQUAL_INT(NUM_TEMPORAL_LAYOUT_FEATURES + NUM_SPECTRAL_FEATURES, preprocessor.getFeatureCount());
+
+    ingestAll(preprocessor, adc, 3 * WINDOW_SIZE);
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    computeSpectralFeatures(preprocessor.getWindow(), spectral);
+    TEST_ASSERT_EQUAL_MEMORY(spectral, &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES],
+                             sizeof(spectral));
+
+    float wavelet[NUM_WAVELET_FEATURES];
+    preprocessor.setFeatureLayout(FEATURE_LAYOUT_WAVELET);
+    TEST_ASSERT_EQUAL_INT(MAX_FEATURES - NUM_COMPLEXITY_FEATURES, preprocessor.getFeatureCount());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    computeWaveletFeatures(preprocessor.getWindow(), wavelet);
+    TEST_ASSERT_EQUAL_MEMORY(spectral, &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES],
+                             sizeof(spectral));
+    TEST_ASSERT_EQUAL_MEMORY(wavelet,
+                             &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES + NUM_SPECTRAL_FEATURES],
+                             sizeof(wavelet));
+
+    float complexity[NUM_COMPLEXITY_FEATURES];
+    preprocessor.setFeatureLayout(FEATURE_LAYOUT_COMPLEXITY);
+    TEST_ASSERT_EQUAL_INT(MAX_FEATURES, preprocessor.getFeatureCount());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    computeComplexityFeatures(preprocessor.getWindow(), complexity);
+    TEST_ASSERT_EQUAL_MEMORY(wavelet,
+                             &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES + NUM_SPECTRAL_FEATURES],
+                             sizeof(wavelet));
+    TEST_ASSERT_EQUAL_MEMORY(complexity, &preprocessor.getFeatures()[MAX_FEATURES - NUM_COMPLEXITY_FEATURES],
+                             sizeof(complexity));
+}
+
+void test_feature_groups_are_independent(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static BITalinoMultiChannelPreprocessor<1> multi;
+    static int adc[3 * WINDOW_SIZE];
+    static float temporal[NUM_TEMPORAL_LAYOUT_FEATURES];
+    float wavelet[NUM_WAVELET_FEATURES];
+    float complexity[NUM_COMPLEXITY_FEATURES];
+
+    srand(41);
+    for (int i = 0; i < 3 * WINDOW_SIZE; i++)
+        adc[i] = 512 + (int)(25 * std::sin(i * 0.2)) + rand() % 11 - 5;
+
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 3 * WINDOW_SIZE);
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+    memcpy(temporal, preprocessor.getFeatures(), sizeof(temporal));
+
+    // Complexité seule : ni FFT ni DWT, le groupe suit le bloc temporel
+    preprocessor.setFeatureGroups(FEATURE_GROUP_COMPLEXITY);
+    TEST_ASSERT_EQUAL_INT(NUM_TEMPORAL_LAYOUT_FEATURES + NUM_COMPLEXITY_FEATURES, preprocessor.getFeatureCount());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    computeComplexityFeatures(preprocessor.getWindow(), complexity);
+    TEST_ASSERT_EQUAL_MEMORY(temporal, preprocessor.getFeatures(), sizeof(temporal));
+    TEST_ASSERT_EQUAL_MEMORY(complexity, &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES],
+                             sizeof(complexity));
+
+    // Ondelettes + complexité, sans spectral
+    preprocessor.setFeatureGroups(FEATURE_GROUP_WAVELET | FEATURE_GROUP_COMPLEXITY);
+    TEST_ASSERT_EQUAL_INT(MAX_FEATURES - NUM_SPECTRAL_FEATURES, preprocessor.getFeatureCount());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    computeWaveletFeatures(preprocessor.getWindow(), wavelet);
+    TEST_ASSERT_EQUAL_MEMORY(wavelet, &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES], sizeof(wavelet));
+    TEST_ASSERT_EQUAL_MEMORY(complexity,
+                             &preprocessor.getFeatures()[NUM_TEMPORAL_LAYOUT_FEATURES + NUM_WAVELET_FEATURES],
+                             sizeof(complexity));
+
+    // Bits inconnus ignorés ; versions historiques = groupes emboîtés
+    preprocessor.setFeatureGroups(0xF0);
+    TEST_ASSERT_EQUAL_UINT(0, preprocessor.getFeatureGroups());
+    preprocessor.setFeatureLayout(FEATURE_LAYOUT_WAVELET);
+    TEST_ASSERT_EQUAL_UINT(FEATURE_GROUP_SPECTRAL | FEATURE_GROUP_WAVELET, preprocessor.getFeatureGroups());
+    preprocessor.setFeatureLayout(7);
+    TEST_ASSERT_EQUAL_UINT(0, preprocessor.getFeatureGroups());
+
+    multi.setFeatureGroups(FEATURE_GROUP_COMPLEXITY);
+    TEST_ASSERT_EQUAL_INT(NUM_TEMPORAL_LAYOUT_FEATURES + NUM_COMPLEXITY_FEATURES, multi.getChannelFeatureCount());
+}
+
+// Entropies par énumération complète des paires (référence O(n²), double)
+static void naiveEntropyMatches(const float *x, int n, float r, long &matches_m, long &matches_m1,
+                                double &phi_m, double &phi_m1)
+{
+    const int m = COMPLEXITY_EMBEDDING;
+    matches_m = 0;
+    matches_m1 = 0;
+    phi_m = 0;
+    phi_m1 = 0;
+
+    for (int len = m; len <= m + 1; len++)
+    {
+        int templates = n - len + 1;
+        for (int i = 0; i < templates; i++)
+        {
+            int close = 0;
+            for (int j = 0; j < templates; j++)
+            {
+                bool match = true;
+                for (int k = 0; k < len && match; k++)
+                    match = std::abs(x[i + k] - x[j + k]) <= r;
+                close += match ? 1 : 0;
+                if (match && j > i && i < n - m && j < n - m)
+                    (len == m ? matches_m : matches_m1)++;
+            }
+            (len == m ? phi_m : phi_m1) += std::log(close / (double)templates) / templates;
+        }
+    }
+}
+
+void test_complexity_features_match_naive_and_bounds(void)
+{
+    float signal[WINDOW_SIZE];
+    float features[NUM_COMPLEXITY_FEATURES];
+    EntropyMatchCounts counts;
+    long matches_m;
+    long matches_m1;
+    double phi_m;
+    double phi_m1;
+
+    // Mêmes paires que l'énumération complète, en examinant bien moins de candidates
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 83);
+    double mean = 0;
+    double m2 = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        mean += signal[i] / WINDOW_SIZE;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        m2 += (signal[i] - mean) * (signal[i] - mean);
+    float r = COMPLEXITY_TOLERANCE * (float)std::sqrt(m2 / WINDOW_SIZE);
+
+    countEntropyMatches(signal, WINDOW_SIZE, r, counts);
+    naiveEntropyMatches(signal, WINDOW_SIZE, r, matches_m, matches_m1, phi_m, phi_m1);
+    TEST_ASSERT_EQUAL_INT(matches_m, counts.matches_m);
+    TEST_ASSERT_EQUAL_INT(matches_m1, counts.matches_m1);
+    TEST_ASSERT_GREATER_THAN(0, counts.matches_m1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, phi_m, counts.phi_m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, phi_m1, counts.phi_m1);
+    TEST_ASSERT_LESS_THAN(COMPLEXITY_MAX_PAIRS / 3, counts.candidates);
+
+    computeComplexityFeatures(signal, features);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, std::log((double)matches_m / matches_m1), features[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, phi_m - phi_m1, features[1]);
+
+    // Pire cas : signal plat, toutes les paires sont candidates
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        signal[i] = 12.5f;
+    countEntropyMatches(signal, WINDOW_SIZE, 0.0f, counts);
+    TEST_ASSERT_EQUAL_INT(COMPLEXITY_MAX_PAIRS, counts.candidates);
+    computeComplexityFeatures(signal, features);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, features[0]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, features[2]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, features[3]);
+
+    // Dimensions fractales : ~1 pour une courbe lisse, ~2 pour un bruit blanc
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        signal[i] = 40.0f * std::sin(2 * M_PI * 2.0f * i / SAMPLE_RATE);
+    computeComplexityFeatures(signal, features);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1.0f, features[3]);
+
+    // Katz : formule de référence en double
+    double line_length = 0;
+    double extent = 0;
+    for (int i = 1; i < WINDOW_SIZE; i++)
+    {
+        line_length += std::abs(signal[i] - signal[i - 1]);
+        extent = std::max(extent, (double)std::abs(signal[i] - signal[0]));
+    }
+    double log_steps = std::log(WINDOW_SIZE - 1.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, log_steps / (log_steps + std::log(extent / line_length)), features[2]);
+
+    srand(89);
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        signal[i] = (rand() % 2001 - 1000) / 10.0f;
+    computeComplexityFeatures(signal, features);
+    TEST_ASSERT_FLOAT_WITHIN(0.15f, 2.0f, features[3]);
+    TEST_ASSERT_GREATER_THAN(1.5f, features[2]);
+    TEST_ASSERT_GREATER_THAN(1.5f, features[0]);
+}
+
+// Amplitude crête d'une composante à frequency Hz sur la fenêtre (DFT directe)
+static float dftAmplitude(const float *window, unsigned frequency)
+{
+    double re = 0;
+    double im = 0;
+    for (int n = 0; n < WINDOW_SIZE; n++)
+    {
+        double angle = 2.0 * M_PI * frequency * n / SAMPLE_RATE;
+        re += window[n] * std::cos(angle);
+        im -= window[n] * std::sin(angle);
+    }
+    return (float)(2.0 * std::sqrt(re * re + im * im) / WINDOW_SIZE);
+}
+
+void test_goertzel_bank_matches_window_dft(void)
+{
+    static GoertzelBank<3, 10, 50> bank;
+    static float stream[40 * WINDOW_SIZE];
+    int total = 40 * WINDOW_SIZE;
+
+    generateEEGLikeSignal(stream, total, 41);
+    for (int n = 0; n < total; n++)
+        stream[n] += 20.0f * std::sin(2 * M_PI * 3.0f * n / SAMPLE_RATE) +
+                     5.0f * std::sin(2 * M_PI * 50.0f * n / SAMPLE_RATE + 0.3f);
+
+    bank.reset();
+    for (int n = 0; n < total; n++)
+    {
+        bank.update(stream[n], n >= WINDOW_SIZE ? stream[n - WINDOW_SIZE] : 0.0f);
+
+        if (n >= WINDOW_SIZE && n % 89 == 0)
+        {
+            const float *window = &stream[n + 1 - WINDOW_SIZE];
+            for (int b = 0; b < 3; b++)
+            {
+                float expected = dftAmplitude(window, bank.frequency(b));
+                TEST_ASSERT_FLOAT_WITHIN(0.01f * std::max(1.0f, expected), expected, bank.magnitude(b));
+            }
+        }
+    }
+}
+
+void test_goertzel_bank_stays_bounded(void)
+{
+    // ~1h30 d'acquisition : l'erreur d'arrondi ne doit pas s'accumuler
+    static GoertzelBank<3, 50> bank;
+    static float ring[WINDOW_SIZE];
+    float window[WINDOW_SIZE];
+    int total = 1000000;
+
+    memset(ring, 0, sizeof(ring));
+    bank.reset();
+    srand(43);
+    for (int n = 0; n < total; n++)
+    {
+        float x = 30.0f * std::sin(2 * M_PI * 3.0f * n / SAMPLE_RATE) + (rand() % 2001 - 1000) / 50.0f;
+        bank.update(x, ring[n % WINDOW_SIZE]);
+        ring[n % WINDOW_SIZE] = x;
+    }
+
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        window[i] = ring[(total + i) % WINDOW_SIZE];
+
+    for (int b = 0; b < 2; b++)
+    {
+        float expected = dftAmplitude(window, bank.frequency(b));
+        TEST_ASSERT_FLOAT_WITHIN(0.01f * std::max(1.0f, expected), expected, bank.magnitude(b));
+    }
+}
+
+void test_goertzel_bank_follows_preprocessor_windows(void)
+{
+    static BITalinoEEGPreprocessor per_sample;
+    static BITalinoEEGPreprocessor block;
+    static int adc[5 * WINDOW_SIZE];
+    int total = 5 * WINDOW_SIZE;
+
+    for (int i = 0; i < total; i++)
+        adc[i] = 512 + (int)(12 * std::sin(2 * M_PI * 3.0 * i / SAMPLE_RATE)) + i % 5;
+
+    per_sample.begin();
+    block.begin();
+    for (int i = 0; i < total; i++)
+        per_sample.addSample(adc[i]);
+    ingestAll(block, adc, total);
+
+    const EEGGoertzelBank &bank = per_sample.getGoertzelBank();
+    for (int b = 0; b < EEGGoertzelBank::NumBins; b++)
+    {
+        float expected = dftAmplitude(per_sample.getWindow(), bank.frequency(b));
+        TEST_ASSERT_FLOAT_WITHIN(0.01f * std::max(1.0f, expected), expected, bank.magnitude(b));
+
+        float from_sample = bank.magnitude(b);
+        float from_block = block.getGoertzelBank().magnitude(b);
+        TEST_ASSERT_EQUAL_MEMORY(&from_sample, &from_block, sizeof(float));
+    }
+}
+
+void test_haar_lifting_matches_direct_transform(void)
+{
+    // Longueur 128 : tous les niveaux sont pairs, Haar est alors orthonormale
+    const int length = 128;
+    const int levels = 3;
+    float data[length];
+    float approx[length];
+    float expected_detail[levels][length / 2];
+    float features[LiftingDWT<HaarWavelet, levels>::NumFeatures];
+
+    generateEEGLikeSignal(approx, length, 47);
+    memcpy(data, approx, sizeof(data));
+
+    double signal_energy = 0;
+    for (int i = 0; i < length; i++)
+        signal_energy += (double)approx[i] * approx[i];
+
+    // Transformée directe : (a + b) / √2 et (b − a) / √2
+    int n = length;
+    for (int level = 0; level < levels; level++)
+    {
+        for (int i = 0; i < n / 2; i++)
+        {
+            float a = approx[2 * i];
+            float b = approx[2 * i + 1];
+            expected_detail[level][i] = (b - a) / std::sqrt(2.0f);
+            approx[i] = (a + b) / std::sqrt(2.0f);
+        }
+        n /= 2;
+    }
+
+    LiftingDWT<HaarWavelet, levels>::transform(data, length, features);
+
+    int stride = 1;
+    for (int level = 0; level < levels; level++)
+    {
+        for (int i = 0; i < (length / stride) / 2; i++)
+            TEST_ASSERT_FLOAT_WITHIN(1e-3f, expected_detail[level][i], data[(2 * i + 1) * stride]);
+        stride *= 2;
+    }
+    for (int i = 0; i < length / stride; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, approx[i], data[i * stride]);
+
+    // Parseval : la somme des énergies de bandes est l'énergie du signal
+    double band_energy = 0;
+    double relative = 0;
+    for (int band = 0; band <= levels; band++)
+    {
+        band_energy += features[band * WAVELET_FEATURES_PER_BAND];
+        relative += features[band * WAVELET_FEATURES_PER_BAND + 2];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4 * signal_energy, signal_energy, band_energy);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, relative);
+}
+
+// Une rampe est annulée par toute ondelette à au moins 2 moments nuls
+// (hors bords, où l'extension symétrique crée un coude)
+template <class Wavelet>
+static void assertRampHasNoInteriorDetail(void)
+{
+    float data[WINDOW_SIZE];
+    float features[LiftingDWT<Wavelet, 1>::NumFeatures];
+
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        data[i] = 3.0f + 0.5f * i;
+
+    LiftingDWT<Wavelet, 1>::transform(data, WINDOW_SIZE, features);
+
+    for (int i = 9; i < WINDOW_SIZE - 9; i += 2)
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, data[i]);
+    for (int i = 10; i < WINDOW_SIZE - 10; i += 2)
+        TEST_ASSERT_FLOAT_WITHIN(2e-2f, std::sqrt(2.0f) * (3.0f + 0.5f * i), data[i]);
+}
+
+void test_wavelet_vanishing_moments(void)
+{
+    assertRampHasNoInteriorDetail<LeGall53Wavelet>();
+    assertRampHasNoInteriorDetail<CDF97Wavelet>();
+}
+
+void test_wavelet_features_localize_band(void)
+{
+    // Seuils établis pour CDF 9/7 (Haar et LeGall 5/3 fuient davantage vers
+    // les bandes voisines) : transformée explicite, indépendante de EEG_DWT_WAVELET
+    typedef LiftingDWT<CDF97Wavelet, 5> Transform;
+    float window[WINDOW_SIZE];
+    float scratch[WINDOW_SIZE];
+    float features[Transform::NumFeatures];
+    const int last = 5;
+
+    // 60 Hz tombe dans D1 (44.5-89 Hz)
+    generateSine(window, 60.0f, 40.0f);
+    memcpy(scratch, window, sizeof(scratch));
+    Transform::transform(scratch, WINDOW_SIZE, features);
+    TEST_ASSERT_GREATER_THAN(0.8f, features[2]);
+
+    // 3 Hz : énergie concentrée dans D5 + A5 (0-5.6 Hz)
+    generateSine(window, 3.0f, 40.0f);
+    memcpy(scratch, window, sizeof(scratch));
+    Transform::transform(scratch, WINDOW_SIZE, features);
+    TEST_ASSERT_GREATER_THAN(0.8f, features[(last - 1) * WAVELET_FEATURES_PER_BAND + 2] +
+                                       features[last * WAVELET_FEATURES_PER_BAND + 2]);
+    TEST_ASSERT_LESS_THAN(0.01f, features[2]);
+
+    // Étage du préprocesseur : transformée configurée sur une copie, la
+    // fenêtre source n'est pas modifiée
+    float expected[NUM_WAVELET_FEATURES];
+    float actual[NUM_WAVELET_FEATURES];
+    memcpy(scratch, window, sizeof(scratch));
+    EEGWaveletTransform::transform(scratch, WINDOW_SIZE, expected);
+    computeWaveletFeatures(window, actual);
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(actual));
+
+    float copy[WINDOW_SIZE];
+    memcpy(copy, window, sizeof(copy));
+    computeWaveletFeatures(window, actual);
+    TEST_ASSERT_EQUAL_MEMORY(copy, window, sizeof(copy));
+}
+
+void test_multichannel_biquad_matches_single_channel(void)
+{
+    const int channels = BITALINO_NUM_ANALOG_CHANNELS;
+    static float signal[channels][2 * WINDOW_SIZE];
+    BiquadCascade<BANDPASS_NUM_SECTIONS> single[channels];
+    MultiChannelBiquadCascade<BANDPASS_NUM_SECTIONS, channels> multi;
+
+    for (int c = 0; c < channels; c++)
+        generateEEGLikeSignal(signal[c], 2 * WINDOW_SIZE, 53 + c);
+
+    for (int i = 0; i < 2 * WINDOW_SIZE; i++)
+    {
+        float frame[channels];
+        float out[channels];
+        for (int c = 0; c < channels; c++)
+            frame[c] = signal[c][i];
+
+        multi.processFrame(frame, out);
+
+        for (int c = 0; c < channels; c++)
+        {
+            float expected = single[c].process(signal[c][i]);
+            TEST_ASSERT_EQUAL_MEMORY(&expected, &out[c], sizeof(float));
+        }
+    }
+}
+
+#ifndef BITALINO_FIXED_POINT
+void test_multichannel_preprocessor_matches_single_channel(void)
+{
+    const int channels = 3;
+    static BITalinoMultiChannelPreprocessor<channels> multi;
+    static BITalinoEEGPreprocessor single[channels];
+    static int frames[4 * WINDOW_SIZE][channels];
+    int total = 4 * WINDOW_SIZE;
+
+    srand(59);
+    for (int i = 0; i < total; i++)
+        for (int c = 0; c < channels; c++)
+            frames[i][c] = 512 + (int)((10 + 15 * c) * std::sin(i * (0.1 + 0.2 * c))) + rand() % 9 - 4;
+
+    multi.reset();
+    multi.setHopSize(45);
+    multi.setFeatureLayout(FEATURE_LAYOUT_SPECTRAL);
+    multi.setChannelFiltered(channels - 1, false);
+    for (int c = 0; c < channels; c++)
+    {
+        single[c].begin();
+        single[c].setHopSize(45);
+        single[c].setFeatureLayout(FEATURE_LAYOUT_SPECTRAL);
+    }
+
+    int windows = 0;
+    for (int i = 0; i < total; i++)
+    {
+        bool ready = multi.addFrame(frames[i]);
+        for (int c = 0; c < channels; c++)
+            TEST_ASSERT_EQUAL(ready, single[c].addSample(frames[i][c]));
+        if (ready)
+            windows++;
+    }
+    TEST_ASSERT_EQUAL_INT(1 + (total - WINDOW_SIZE) / 45, windows);
+    TEST_ASSERT_EQUAL_INT(channels * single[0].getFeatureCount(), multi.getFeatureCount());
+
+    TEST_ASSERT_TRUE(multi.extractFeatures());
+    for (int c = 0; c < channels - 1; c++)
+    {
+        TEST_ASSERT_TRUE(single[c].extractFeatures());
+        TEST_ASSERT_EQUAL_MEMORY(single[c].getWindow(), multi.getWindow(c), WINDOW_SIZE * sizeof(float));
+        TEST_ASSERT_EQUAL_MEMORY(single[c].getFeatures(), multi.getChannelFeatures(c),
+                                 single[c].getFeatureCount() * sizeof(float));
+    }
+
+    // Voie non filtrée : la fenêtre « filtrée » est la fenêtre brute
+    int last = channels - 1;
+    TEST_ASSERT_EQUAL_MEMORY(single[last].getRawWindow(), multi.getWindow(last), WINDOW_SIZE * sizeof(float));
+    TEST_ASSERT_EQUAL_PTR(&multi.getFeatures()[last * multi.getChannelFeatureCount()],
+                          multi.getChannelFeatures(last));
+}
+#endif
+
+// Sous-ensemble sans médiane ni moments d'ordre 3/4 : mean, std, rms, zcr
+#define PRUNED_FEATURE_MASK ((1u << 0) | (1u << 2) | (1u << 7) | (1u << 25))
+
+template <uint32_t Mask>
+static void assertFeatureSetMatchesFull(const float *data, int length)
+{
+    typedef TemporalFeatureSet<Mask> Set;
+    SegmentStats stats;
+    float full[TEMPORAL_FEATURE_TABLE_SIZE];
+    float from_stats[TEMPORAL_FEATURE_TABLE_SIZE];
+    float pruned[TEMPORAL_FEATURE_TABLE_SIZE];
+
+    computeSegmentStats(data, length, stats);
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_EXTENDED>::write(stats, full);
+    Set::write(stats, from_stats);
+    Set::compute(data, length, pruned);
+
+    int out = 0;
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        if (!(Mask & (1u << i)))
+        {
+            TEST_ASSERT_EQUAL_INT(-1, Set::indexOf(i));
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(out, Set::indexOf(i));
+        TEST_ASSERT_EQUAL_MEMORY(&full[i], &from_stats[out], sizeof(float));
+        TEST_ASSERT_EQUAL_MEMORY(&full[i], &pruned[out], sizeof(float));
+        out++;
+    }
+    TEST_ASSERT_EQUAL_INT(Set::NumFeatures, out);
+}
+
+void test_feature_set_subsets_match_full_extractor(void)
+{
+    float signal[WINDOW_SIZE];
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 61);
+
+    assertFeatureSetMatchesFull<TEMPORAL_FEATURE_MASK_ALL>(signal, WINDOW_SIZE);
+    assertFeatureSetMatchesFull<TEMPORAL_FEATURE_MASK_EXTENDED>(signal, WINDOW_SIZE);
+    assertFeatureSetMatchesFull<TEMPORAL_FEATURE_MASK_NONLINEAR>(signal, SEGMENT_SIZE);
+    assertFeatureSetMatchesFull<TEMPORAL_FEATURE_MASK_UNIQUE>(signal, WINDOW_SIZE);
+    assertFeatureSetMatchesFull<PRUNED_FEATURE_MASK>(signal, WINDOW_SIZE);
+    assertFeatureSetMatchesFull<PRUNED_FEATURE_MASK>(signal, SEGMENT_SIZE);
+    assertFeatureSetMatchesFull<EEG_TEMPORAL_FEATURE_MASK>(signal, WINDOW_SIZE);
+
+    // Élagage : ni médiane, ni moments d'ordre 3/4, ni différences
+    const unsigned stats = TemporalFeatureSet<PRUNED_FEATURE_MASK>::Stats;
+    TEST_ASSERT_EQUAL_UINT(STAT_SUM | STAT_SUM_SQ | STAT_M2 | STAT_ZERO_CROSSINGS, stats);
+    TEST_ASSERT_EQUAL_INT(4, TemporalFeatureSet<PRUNED_FEATURE_MASK>::NumFeatures);
+}
+
+void test_feature_table_duplicates(void)
+{
+    float signal[WINDOW_SIZE];
+    float full[TEMPORAL_FEATURE_TABLE_SIZE];
+    SegmentStats stats;
+
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 67);
+    computeSegmentStats(signal, WINDOW_SIZE, stats);
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_EXTENDED>::write(stats, full);
+
+    // 3 doublons historiques, hjorth_activity et line_length
+    TEST_ASSERT_EQUAL_INT(TEMPORAL_FEATURE_TABLE_SIZE - 5, temporalFeatureCount(TEMPORAL_FEATURE_MASK_UNIQUE));
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+    {
+        int alias = TEMPORAL_FEATURE_TABLE[i].alias_of;
+        if (alias < 0)
+            continue;
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f * std::max(1.0f, std::abs(full[alias])), full[alias], full[i]);
+    }
+
+    for (int i = 0; i < TEMPORAL_FEATURE_TABLE_SIZE; i++)
+        for (int j = i + 1; j < TEMPORAL_FEATURE_TABLE_SIZE; j++)
+            TEST_ASSERT_TRUE(strcmp(TEMPORAL_FEATURE_TABLE[i].name, TEMPORAL_FEATURE_TABLE[j].name) != 0);
+}
+
+void test_nonlinear_features_share_fused_pass(void)
+{
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_NONLINEAR> Nonlinear;
+    const int mobility = Nonlinear::indexOf(27);
+    const int complexity = Nonlinear::indexOf(28);
+    const int tkeo = Nonlinear::indexOf(30);
+    float signal[WINDOW_SIZE];
+    float out[NUM_NONLINEAR_FEATURES * (1 + NUM_SEGMENTS)];
+    float expected[NUM_NONLINEAR_FEATURES];
+
+    // Hors du masque par défaut : la passe du modèle actuel ne change pas
+    TEST_ASSERT_EQUAL_UINT(0, EEG_TEMPORAL_FEATURE_MASK & TEMPORAL_FEATURE_MASK_NONLINEAR);
+    TEST_ASSERT_EQUAL_UINT(0, TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL>::Stats & (STAT_DIFF2_SQ | STAT_TKEO));
+    TEST_ASSERT_EQUAL_UINT(STAT_SUM | STAT_M2 | STAT_ABS_DIFF | STAT_ABS_DIFF_DEV | STAT_DIFF2_SQ | STAT_TKEO,
+                           Nonlinear::Stats);
+
+    // Sinusoïde : mobilité 2·sin(ω/2), complexité 1, Teager–Kaiser A²·sin²(ω)
+    const float amplitude = 40.0f;
+    const float omega = 2 * M_PI * 10.0f / SAMPLE_RATE;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        signal[i] = amplitude * std::sin(omega * i);
+    Nonlinear::compute(signal, WINDOW_SIZE, expected);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f * 2 * std::sin(omega / 2), 2 * std::sin(omega / 2), expected[mobility]);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, expected[complexity]);
+    float tkeo_sine = amplitude * amplitude * std::sin(omega) * std::sin(omega);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f * tkeo_sine, tkeo_sine, expected[tkeo]);
+
+    // Formules directes sur un signal EEG synthétique
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 71);
+    double mean = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        mean += signal[i];
+    mean /= WINDOW_SIZE;
+    double variance = 0;
+    double diff_power = 0;
+    double diff2_power = 0;
+    double teager = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        variance += (signal[i] - mean) * (signal[i] - mean) / WINDOW_SIZE;
+        if (i > 0)
+            diff_power += (double)(signal[i] - signal[i - 1]) * (signal[i] - signal[i - 1]) / (WINDOW_SIZE - 1);
+        if (i > 0 && i < WINDOW_SIZE - 1)
+        {
+            double diff2 = (double)signal[i + 1] - 2.0 * signal[i] + signal[i - 1];
+            diff2_power += diff2 * diff2 / (WINDOW_SIZE - 2);
+            teager += ((double)signal[i] * signal[i] - (double)signal[i - 1] * signal[i + 1]) / (WINDOW_SIZE - 2);
+        }
+    }
+    double ref_mobility = std::sqrt(diff_power / variance);
+    double ref_complexity = std::sqrt(diff2_power / diff_power) / ref_mobility;
+
+    Nonlinear::compute(signal, WINDOW_SIZE, expected);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f * ref_mobility, ref_mobility, expected[mobility]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f * ref_complexity, ref_complexity, expected[complexity]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::abs(teager), teager, expected[tkeo]);
+
+    // Fenêtre par fusion des segments : termes de jonction compris
+    SegmentStats window_stats;
+    Nonlinear::computeWindow(signal, out, &window_stats);
+    for (int i = 0; i < NUM_NONLINEAR_FEATURES; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::max(1.0f, std::abs(expected[i])), expected[i], out[i]);
+
+    // La cascade reprend le Teager–Kaiser de la passe des features
+    WindowActivity activity;
+    computeWindowActivity<Nonlinear::Stats>(window_stats, signal, activity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::abs(teager), meanTeagerKaiser(signal, WINDOW_SIZE), activity.tkeo);
+
+    // Flux échantillon par échantillon (MomentAccumulator::add)
+    MomentAccumulator stream;
+    SegmentStats stream_stats;
+    stream.reset();
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        stream.add(signal[i]);
+    stream.toSegmentStats(stream_stats);
+    Nonlinear::write(stream_stats, out);
+    for (int i = 0; i < NUM_NONLINEAR_FEATURES; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::max(1.0f, std::abs(expected[i])), expected[i], out[i]);
+
+    // Chaîne en virgule fixe
+    eeg_fixed_t signal_q[WINDOW_SIZE];
+    float quantized[WINDOW_SIZE];
+    float actual[NUM_NONLINEAR_FEATURES];
+    SegmentStats stats;
+    FixedSegmentStats fixed_stats;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        signal_q[i] = (eeg_fixed_t)std::lround(signal[i] * EEG_FIXED_ONE);
+        quantized[i] = fixedToMicrovolts(signal_q[i]);
+    }
+    Nonlinear::compute(quantized, WINDOW_SIZE, expected);
+    computeFixedSegmentStats(signal_q, WINDOW_SIZE, fixed_stats);
+    fixedToSegmentStats(fixed_stats, stats);
+    Nonlinear::write(stats, actual);
+    for (int i = 0; i < NUM_NONLINEAR_FEATURES; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * std::max(1.0f, std::abs(expected[i])), expected[i], actual[i]);
+}
+
+void test_fast_math_error_bounds(void)
+{
+    double max_rel_log = 0;
+    double max_abs_log = 0;
+    double max_rel_sqrt = 0;
+
+    for (double lx = std::log(1e-8); lx < std::log(2e4); lx += 1e-4)
+    {
+        float x = (float)std::exp(lx);
+        double exact = std::log((double)x);
+        double error = std::abs(fastLog(x) - exact);
+        max_abs_log = std::max(max_abs_log, error);
+        if (std::abs(exact) > 1e-3)
+            max_rel_log = std::max(max_rel_log, error / std::abs(exact));
+
+        double root = std::sqrt((double)x);
+        max_rel_sqrt = std::max(max_rel_sqrt, std::abs(fastSqrt(x) - root) / root);
+    }
+    TEST_ASSERT_LESS_THAN(1.6e-7, max_rel_log);
+    TEST_ASSERT_LESS_THAN(2e-6, max_abs_log);
+    TEST_ASSERT_LESS_THAN(2e-7, max_rel_sqrt);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fastSqrt(0.0f));
+
+    // Features : entropie et grandeurs à racine contre libm, par segment
+    float signal[WINDOW_SIZE];
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 71);
+    for (int seg = 0; seg <= NUM_SEGMENTS; seg++)
+    {
+        const float *data = seg == 0 ? signal : &signal[(seg - 1) * SEGMENT_SIZE];
+        int length = seg == 0 ? WINDOW_SIZE : SEGMENT_SIZE;
+        SegmentStats stats;
+        float actual[NUM_TEMPORAL_FEATURES];
+        computeSegmentStats(data, length, stats);
+        writeTemporalFeatures(stats, actual);
+
+        double entropy = 0;
+        for (int i = 0; i < length; i++)
+        {
+            double p = std::abs(data[i]) + 1e-8;
+            entropy -= p * std::log(p);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5 * std::abs(entropy), entropy, actual[12]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f * actual[2], std::sqrt(stats.m2 / length), actual[2]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f * actual[7], std::sqrt(stats.sum_sq / length), actual[7]);
+    }
+}
+
+static void assertMergedStatsClose(const SegmentStats &expected, SegmentStats actual, float rel_tol)
+{
+    float expected_features[NUM_TEMPORAL_FEATURES];
+    float actual_features[NUM_TEMPORAL_FEATURES];
+
+    TEST_ASSERT_EQUAL_INT(expected.length, actual.length);
+    TEST_ASSERT_EQUAL_INT(expected.zero_crossings, actual.zero_crossings);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+
+    // La médiane n'est pas fusionnable
+    actual.median = expected.median;
+    writeTemporalFeatures(expected, expected_features);
+    writeTemporalFeatures(actual, actual_features);
+
+    for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+    {
+        if (isRatioFeature(i))
+            continue;
+        float scale = (i == 0 || i == 18) ? expected_features[2] : std::abs(expected_features[i]);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(rel_tol * std::max(1.0f, scale), expected_features[i], actual_features[i], "merge");
+    }
+}
+
+void test_moment_merge_matches_single_pass(void)
+{
+    float signal[WINDOW_SIZE];
+    SegmentStats expected;
+    SegmentStats stats;
+    MomentAccumulator merged;
+    MomentAccumulator part;
+    MomentAccumulator streamed;
+
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 17);
+    computeSegmentStats(signal, WINDOW_SIZE, expected);
+
+    // Découpes de tailles inégales (>= 2 échantillons)
+    const int cuts[] = {2, 25, 61, 100, 150, 176, WINDOW_SIZE};
+    int start = 0;
+    merged.reset();
+    for (int k = 0; k < 7; k++)
+    {
+        computeSegmentStats(&signal[start], cuts[k] - start, stats);
+        part.assign(stats, &signal[start]);
+        merged.merge(part);
+        start = cuts[k];
+    }
+    merged.toSegmentStats(stats);
+    assertMergedStatsClose(expected, stats, 1e-4f);
+
+    // Flux échantillon par échantillon
+    streamed.reset();
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        streamed.add(signal[i]);
+    }
+    streamed.toSegmentStats(stats);
+    assertMergedStatsClose(expected, stats, 1e-4f);
+
+    // Fusion de deux fenêtres (contexte long)
+    MomentAccumulator two_windows = merged;
+    two_windows.merge(merged);
+    TEST_ASSERT_EQUAL_INT(2 * WINDOW_SIZE, two_windows.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f * merged.m2, 2 * merged.m2, two_windows.m2);
+}
+
+void test_window_features_from_merged_segments(void)
+{
+    float signal[WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+    float actual[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL,
+                               WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, SEGMENT_REMAINDER_DROP>> FullSet;
+
+    for (unsigned seed = 1; seed <= 5; seed++)
+    {
+        generateEEGLikeSignal(signal, WINDOW_SIZE, seed);
+
+        FullSet::compute(signal, WINDOW_SIZE, expected);
+        for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+            FullSet::compute(&signal[seg * SEGMENT_SIZE], SEGMENT_SIZE, &expected[(1 + seg) * NUM_TEMPORAL_FEATURES]);
+
+        FullSet::computeWindow(signal, actual);
+
+        // Segments : même noyau, identiques au bit près
+        for (int i = NUM_TEMPORAL_FEATURES; i < NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS); i++)
+            TEST_ASSERT_EQUAL_FLOAT(expected[i], actual[i]);
+
+        // Fenêtre : fusion des 7 segments et du reliquat
+        for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+        {
+            if (isRatioFeature(i))
+                continue;
+            float scale = (i == 0 || i == 18) ? expected[2] : std::abs(expected[i]);
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f * std::max(1.0f, scale), expected[i], actual[i]);
+        }
+    }
+}
+
+template <int Policy>
+static void checkSegmentGeometry(const float *signal, float *window_block)
+{
+    typedef WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, Policy> Geometry;
+    typedef TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL, Geometry> FullSet;
+    float expected[NUM_TEMPORAL_FEATURES];
+    float actual[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+
+    FullSet::computeWindow(signal, actual);
+
+    // Segments contigus ; noyau à longueur constante identique au noyau générique
+    int next = 0;
+    for (int seg = 0; seg < NUM_SEGMENTS; seg++)
+    {
+        TEST_ASSERT_EQUAL_INT(next, Geometry::segmentStart(seg));
+        int length = Geometry::segmentLength(seg);
+        FullSet::compute(&signal[next], length, expected);
+        for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+            TEST_ASSERT_EQUAL_FLOAT(expected[i], actual[(1 + seg) * NUM_TEMPORAL_FEATURES + i]);
+        next += length;
+    }
+    TEST_ASSERT_EQUAL_INT(Geometry::Covered, next);
+
+    memcpy(window_block, actual, NUM_TEMPORAL_FEATURES * sizeof(float));
+}
+
+void test_segment_geometry_remainder_policies(void)
+{
+    typedef WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, SEGMENT_REMAINDER_DROP> Drop;
+    typedef WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, SEGMENT_REMAINDER_LAST> Last;
+    typedef WindowGeometry<WINDOW_SIZE, NUM_SEGMENTS, SEGMENT_REMAINDER_SPREAD> Spread;
+
+    // 178 = 7 × 25 + 3
+    static_assert(Drop::Remainder == 3 && Drop::Covered == 175, "DROP : reliquat hors segments");
+    static_assert(Last::segmentLength(6) == 28 && Last::Covered == WINDOW_SIZE, "LAST : dernier segment étendu");
+    static_assert(Spread::segmentLength(2) == 26 && Spread::segmentLength(3) == 25 &&
+                      Spread::segmentStart(3) == 78 && Spread::Covered == WINDOW_SIZE,
+                  "SPREAD : +1 aux premiers segments");
+    static_assert(WindowGeometry<175, 7, SEGMENT_REMAINDER_SPREAD>::segmentLength(0) == 25, "division exacte");
+
+    float signal[WINDOW_SIZE];
+    float window_drop[NUM_TEMPORAL_FEATURES];
+    float window_last[NUM_TEMPORAL_FEATURES];
+    float window_spread[NUM_TEMPORAL_FEATURES];
+
+    generateEEGLikeSignal(signal, WINDOW_SIZE, 31);
+    // Pic sur le dernier échantillon : hors segments avec DROP seulement
+    signal[WINDOW_SIZE - 1] = 500.0f;
+
+    checkSegmentGeometry<SEGMENT_REMAINDER_DROP>(signal, window_drop);
+    checkSegmentGeometry<SEGMENT_REMAINDER_LAST>(signal, window_last);
+    checkSegmentGeometry<SEGMENT_REMAINDER_SPREAD>(signal, window_spread);
+
+    // La fenêtre entière ne dépend pas du découpage et voit toujours le pic
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, window_drop[5]);
+    for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+    {
+        if (isRatioFeature(i))
+            continue;
+        float scale = std::max(1.0f, std::abs(window_drop[i]));
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * scale, window_drop[i], window_last[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f * scale, window_drop[i], window_spread[i]);
+    }
+
+    float segment_features[NUM_TEMPORAL_FEATURES * (1 + NUM_SEGMENTS)];
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL, Drop>::computeWindow(signal, segment_features);
+    TEST_ASSERT_LESS_THAN(500.0f, segment_features[NUM_SEGMENTS * NUM_TEMPORAL_FEATURES + 5]);
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL, Last>::computeWindow(signal, segment_features);
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, segment_features[NUM_SEGMENTS * NUM_TEMPORAL_FEATURES + 5]);
+    TemporalFeatureSet<TEMPORAL_FEATURE_MASK_ALL, Spread>::computeWindow(signal, segment_features);
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, segment_features[NUM_SEGMENTS * NUM_TEMPORAL_FEATURES + 5]);
+}
+
+void test_pipeline_caches_features_per_window(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+    static float first[MAX_FEATURES];
+    static float emitted[MAX_FEATURES];
+
+    generateADCStream(adc, 4 * WINDOW_SIZE, 9);
+    preprocessor.begin();
+    preprocessor.setHopSize(20);
+
+    // Aucune fenêtre : rien à extraire ni à émettre
+    TEST_ASSERT_EQUAL_UINT(0, preprocessor.getWindowSequence());
+    TEST_ASSERT_FALSE(preprocessor.extractFeatures());
+    TEST_ASSERT_FALSE(preprocessor.normalizeFeatures(emitted, MAX_FEATURES));
+
+    preprocessor.addSamples(adc, WINDOW_SIZE);
+    TEST_ASSERT_EQUAL_UINT(1, preprocessor.getWindowSequence());
+    TEST_ASSERT_FALSE(preprocessor.hasFeatures());
+
+    // La sortie déclenche l'extraction
+    TEST_ASSERT_TRUE(preprocessor.normalizeFeatures(emitted, MAX_FEATURES));
+    TEST_ASSERT_TRUE(preprocessor.hasFeatures());
+    memcpy(first, preprocessor.getFeatures(), sizeof(first));
+
+    // Échantillons sans nouvelle fenêtre : features en cache, inchangées
+    preprocessor.addSamples(&adc[WINDOW_SIZE], 19);
+    TEST_ASSERT_EQUAL_UINT(1, preprocessor.getWindowSequence());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(first, preprocessor.getFeatures(), sizeof(first)));
+
+    // Nouvelle fenêtre : cache invalidé
+    preprocessor.addSamples(&adc[WINDOW_SIZE + 19], 1);
+    TEST_ASSERT_EQUAL_UINT(2, preprocessor.getWindowSequence());
+    TEST_ASSERT_FALSE(preprocessor.hasFeatures());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+    TEST_ASSERT_TRUE(memcmp(first, preprocessor.getFeatures(), sizeof(first)) != 0);
+
+    // Changement de layout : cache invalidé, même fenêtre
+    preprocessor.setFeatureLayout(FEATURE_LAYOUT_SPECTRAL);
+    TEST_ASSERT_FALSE(preprocessor.hasFeatures());
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+    TEST_ASSERT_TRUE(preprocessor.hasFeatures());
+
+    preprocessor.reset();
+    TEST_ASSERT_EQUAL_UINT(0, preprocessor.getWindowSequence());
+    TEST_ASSERT_FALSE(preprocessor.hasFeatures());
+}
+
+static SignalQuality qualityOfStream(const int *adc, int length, int gap_at,
+                                     int mains_frequency = EEG_MAINS_FREQUENCY)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    preprocessor.begin(mains_frequency);
+    for (int i = 0; i < length; i++)
+    {
+        if (i == gap_at)
+            preprocessor.markSampleGap();
+        preprocessor.addSample(adc[i]);
+    }
+    preprocessor.extractFeatures();
+    return preprocessor.getSignalQuality();
+}
+
+void test_signal_quality_flags_bad_windows(void)
+{
+    static int clean[4 * WINDOW_SIZE];
+    static int adc[4 * WINDOW_SIZE];
+    const int total = 4 * WINDOW_SIZE;
+    const int window_start = total - WINDOW_SIZE;
+    SignalQuality quality;
+
+    generateADCStream(clean, total, 21);
+    quality = qualityOfStream(clean, total, -1);
+    TEST_ASSERT_TRUE(quality.usable);
+    TEST_ASSERT_GREATER_THAN(0.5f, quality.score);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, quality.saturation);
+    TEST_ASSERT_LESS_THAN(0.05f, quality.line_noise);
+
+    // Saturation : 20 échantillons à 1023
+    memcpy(adc, clean, sizeof(adc));
+    for (int i = 0; i < 20; i++)
+        adc[window_start + 40 + i] = 1023;
+    quality = qualityOfStream(adc, total, -1);
+    TEST_ASSERT_FALSE(quality.usable);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f / WINDOW_SIZE, quality.saturation);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, quality.score);
+
+    // Ligne plate : 60 valeurs identiques, suite marquée dès son début
+    memcpy(adc, clean, sizeof(adc));
+    for (int i = 0; i < 60; i++)
+        adc[window_start + 100 + i] = 512;
+    quality = qualityOfStream(adc, total, -1);
+    TEST_ASSERT_FALSE(quality.usable);
+    TEST_ASSERT_EQUAL_FLOAT(60.0f / WINDOW_SIZE, quality.flatline);
+
+    // Suite plus courte que SQI_FLATLINE_RUN : ignorée ; la ligne plate
+    // sortie de la fenêtre n'est plus comptée
+    memcpy(adc, clean, sizeof(adc));
+    for (int i = 0; i < SQI_FLATLINE_RUN - 1; i++)
+        adc[window_start + 100 + i] = 512;
+    for (int i = 0; i < 60; i++)
+        adc[window_start - 80 + i] = 512;
+    quality = qualityOfStream(adc, total, -1);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, quality.flatline);
+
+    // Secteur : 50 Hz d'amplitude 60 LSB (~190 µV) sur le signal brut
+    for (int i = 0; i < total; i++)
+        adc[i] = clean[i] + (int)std::lround(60 * std::sin(2 * M_PI * 50.0 * i / SAMPLE_RATE));
+    quality = qualityOfStream(adc, total, -1, 50);
+    TEST_ASSERT_FALSE(quality.usable);
+    TEST_ASSERT_GREATER_THAN(SQI_MAX_LINE_NOISE, quality.line_noise);
+
+    // Secteur à 60 Hz : vu seulement si le préprocesseur est configuré pour 60 Hz
+    for (int i = 0; i < total; i++)
+        adc[i] = clean[i] + (int)std::lround(60 * std::sin(2 * M_PI * 60.0 * i / SAMPLE_RATE));
+    quality = qualityOfStream(adc, total, -1, 50);
+    TEST_ASSERT_LESS_THAN(0.05f, quality.line_noise);
+    quality = qualityOfStream(adc, total, -1, 60);
+    TEST_ASSERT_FALSE(quality.usable);
+    TEST_ASSERT_GREATER_THAN(SQI_MAX_LINE_NOISE, quality.line_noise);
+
+    // Trous : comptés tant que l'échantillon qui suit la perte est dans la fenêtre
+    quality = qualityOfStream(clean, total, window_start + 10);
+    TEST_ASSERT_FALSE(quality.usable);
+    TEST_ASSERT_EQUAL_INT(1, quality.gaps);
+    quality = qualityOfStream(clean, total, window_start - 10);
+    TEST_ASSERT_EQUAL_INT(0, quality.gaps);
+    TEST_ASSERT_TRUE(quality.usable);
+}
+
+// Trame BITalino à une voie (A1), encodée comme par le firmware de la carte
+static void encodeSingleChannelFrame(uint8_t seq, int adc, uint8_t *out)
+{
+    out[0] = (uint8_t)((adc & 0x3F) << 2);
+    out[1] = (uint8_t)(adc >> 6);
+    out[2] = (uint8_t)(seq << 4);
+    out[2] |= bitalinoFrameCRC(out, 3);
+}
+
+void test_bitalino_frames_crc_sequence_and_gaps(void)
+{
+    BITalinoFrame frame;
+
+    // Trames de référence (décodage de pyBITalino) : séquence dans le
+    // dernier octet, CRC dans ses 4 bits de poids faible
+    const uint8_t single[] = {0x90, 0x49, 0x5E};
+    TEST_ASSERT_EQUAL_INT(3, bitalinoFrameBytes(1));
+    TEST_ASSERT_TRUE(decodeBITalinoFrame(single, 1, frame));
+    TEST_ASSERT_EQUAL_UINT8(5, frame.seq);
+    TEST_ASSERT_EQUAL_UINT8(1, frame.digital[1]);
+    TEST_ASSERT_EQUAL_UINT16(612, frame.analog[0]);
+
+    const uint8_t full[] = {0x51, 0xCB, 0xEB, 0x00, 0xFF, 0x03, 0x98, 0xB1};
+    const uint16_t full_analog[] = {512, 1023, 3, 700, 45, 17};
+    TEST_ASSERT_EQUAL_INT(8, bitalinoFrameBytes(6));
+    TEST_ASSERT_TRUE(decodeBITalinoFrame(full, 6, frame));
+    TEST_ASSERT_EQUAL_UINT8(11, frame.seq);
+    TEST_ASSERT_EQUAL_UINT8(1, frame.digital[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, frame.digital[3]);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(full_analog, frame.analog, 6);
+
+    // Un bit faux : trame rejetée
+    uint8_t corrupted[3] = {0x90, 0x49 ^ 0x10, 0x5E};
+    TEST_ASSERT_FALSE(decodeBITalinoFrame(corrupted, 1, frame));
+
+    // Flux : 2 octets parasites, trames 600 et 620-622 perdues, trame 640
+    // corrompue ; la dernière fenêtre contient les trois sauts
+    const int total = 4 * WINDOW_SIZE;
+    static int adc[total];
+    static uint8_t stream[3 * total + 2];
+    generateADCStream(adc, total, 23);
+
+    int length = 0;
+    stream[length++] = 0x3C;
+    stream[length++] = 0xA7;
+    for (int i = 0; i < total; i++)
+    {
+        if (i == 600 || (i >= 620 && i <= 622))
+            continue;
+        encodeSingleChannelFrame(i & 0x0F, adc[i], &stream[length]);
+        if (i == 640)
+            stream[length + 1] ^= 0x04;
+        length += 3;
+    }
+
+    static BITalinoEEGPreprocessor preprocessor;
+    BITalinoFrameDecoder<1> decoder;
+    preprocessor.begin();
+
+    int decoded = 0;
+    int gap_events = 0;
+    int lost_frames = 0;
+    int next = 0;
+    for (int k = 0; k < length; k++)
+    {
+        int lost;
+        if (!decoder.push(stream[k], frame, lost))
+            continue;
+
+        next += lost;
+        TEST_ASSERT_EQUAL_UINT16(adc[next], frame.analog[0]);
+        next++;
+
+        decoded++;
+        lost_frames += lost;
+        if (lost > 0)
+        {
+            gap_events++;
+            preprocessor.markSampleGap();
+        }
+        preprocessor.addSample(frame.analog[0]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(total - 5, decoded);
+    TEST_ASSERT_EQUAL_INT(5, lost_frames);
+    TEST_ASSERT_EQUAL_INT(3, gap_events);
+    TEST_ASSERT_TRUE(decoder.getCRCErrors() > 0);
+
+    preprocessor.extractFeatures();
+    TEST_ASSERT_EQUAL_INT(3, preprocessor.getSignalQuality().gaps);
+    TEST_ASSERT_FALSE(preprocessor.getSignalQuality().usable);
+
+    // Flux continu décodé après reset() : aucun trou, fenêtre exploitable
+    decoder.reset();
+    preprocessor.begin();
+    for (int i = 0; i < total; i++)
+    {
+        uint8_t bytes[3];
+        encodeSingleChannelFrame((i + 7) & 0x0F, adc[i], bytes);
+        for (int k = 0; k < 3; k++)
+        {
+            int lost;
+            if (decoder.push(bytes[k], frame, lost))
+            {
+                TEST_ASSERT_EQUAL_INT(0, lost);
+                preprocessor.addSample(frame.analog[0]);
+            }
+        }
+    }
+    preprocessor.extractFeatures();
+    TEST_ASSERT_EQUAL_INT(0, preprocessor.getSignalQuality().gaps);
+    TEST_ASSERT_TRUE(preprocessor.getSignalQuality().usable);
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.getCRCErrors());
+}
+
+void test_cascade_gate_invokes_on_activity_or_keepalive(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+
+    // Mesures reprises de la passe des features = calcul direct sur la fenêtre
+    generateADCStream(adc, 4 * WINDOW_SIZE, 9);
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 4 * WINDOW_SIZE);
+    TEST_ASSERT_TRUE(preprocessor.extractFeatures());
+
+    const float *window = preprocessor.getWindow();
+    double line_length = 0, energy = 0, tkeo = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+    {
+        energy += (double)window[i] * window[i];
+        if (i > 0)
+            line_length += std::fabs((double)window[i] - window[i - 1]);
+        if (i > 0 && i < WINDOW_SIZE - 1)
+            tkeo += (double)window[i] * window[i] - (double)window[i - 1] * window[i + 1];
+    }
+    line_length /= WINDOW_SIZE - 1;
+    energy /= WINDOW_SIZE;
+    tkeo /= WINDOW_SIZE - 2;
+
+    const WindowActivity &activity = preprocessor.getWindowActivity();
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f * line_length, line_length, activity.line_length);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f * energy, energy, activity.energy);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f * energy, tkeo, activity.tkeo);
+
+    // Les trois mesures viennent de la passe des features, quel que soit le
+    // masque (le masque par défaut n'émet pas tkeo)
+    TEST_ASSERT_EQUAL_UINT(CASCADE_WINDOW_STATS, EEGWindowFeatureKernel::Stats & CASCADE_WINDOW_STATS);
+#ifndef BITALINO_FIXED_POINT
+    static float temporal[NUM_TEMPORAL_LAYOUT_FEATURES];
+    SegmentStats window_stats;
+    EEGWindowFeatureKernel::computeWindow(window, temporal, &window_stats);
+    float fused_tkeo = window_stats.tkeo_sum / (WINDOW_SIZE - 2);
+    TEST_ASSERT_EQUAL_MEMORY(&fused_tkeo, &activity.tkeo, sizeof(float));
+
+    // Statistiques supplémentaires sans effet sur les features émises
+    EEGTemporalFeatureSet::computeWindow(window, temporal);
+    TEST_ASSERT_EQUAL_MEMORY(temporal, preprocessor.getFeatures(), sizeof(temporal));
+#endif
+
+    // Porte : fenêtres calmes filtrées sauf tous les 4, suspectes et
+    // forcées toujours transmises
+    CascadeGate gate;
+    gate.setThresholds(10.0f, 1000.0f, 100.0f);
+    gate.setKeepAlive(4);
+
+    WindowActivity quiet = {1.0f, 50.0f, 5.0f};
+    WindowActivity spiky = {1.0f, 50.0f, 150.0f};
+    WindowActivity loud = {1.0f, 2000.0f, 5.0f};
+
+    TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_TRUE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_TRUE(gate.shouldInvoke(spiky));
+    TEST_ASSERT_TRUE(gate.shouldInvoke(loud));
+    TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_TRUE(gate.shouldInvoke(quiet, true));
+    TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+
+    TEST_ASSERT_EQUAL_UINT32(4, gate.getInvokedCount());
+    TEST_ASSERT_EQUAL_UINT32(2, gate.getSuspiciousCount());
+    TEST_ASSERT_EQUAL_UINT32(1, gate.getKeepAliveCount());
+    TEST_ASSERT_EQUAL_UINT32(5, gate.getGatedCount());
+
+    // Sans contrôle périodique, une fenêtre calme n'est jamais transmise
+    gate.reset();
+    gate.setKeepAlive(0);
+    for (int i = 0; i < 50; i++)
+        TEST_ASSERT_FALSE(gate.shouldInvoke(quiet));
+    TEST_ASSERT_EQUAL_UINT32(50, gate.getGatedCount());
+}
+
+void test_polyphase_resampler_rates_and_alias_rejection(void)
+{
+    typedef PolyphaseResampler<1000> Down1000;
+    static Down1000 resampler;
+    static float in[5000];
+    static float out[Down1000::maxOutput(5000)];
+    static float chunked[Down1000::maxOutput(5000)];
+
+    TEST_ASSERT_EQUAL_INT(89, Down1000::Up);
+    TEST_ASSERT_EQUAL_INT(500, Down1000::Down);
+
+    // 10 Hz : exactement 178 sorties par seconde, amplitude et phase conservées
+    for (int i = 0; i < 5000; i++)
+        in[i] = 100.0f * std::sin(2 * M_PI * 10.0 * i / 1000.0);
+    resampler.reset();
+    int produced = resampler.process(in, 5000, out);
+    TEST_ASSERT_EQUAL_INT(5 * SAMPLE_RATE, produced);
+
+    const double delay = (Down1000::NumTaps - 1) / 2.0 / (Down1000::Up * 1000.0);
+    for (int m = 20; m < produced; m++)
+    {
+        double expected = 100.0 * std::sin(2 * M_PI * 10.0 * ((double)m / SAMPLE_RATE - delay));
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, expected, out[m]);
+    }
+
+    // Blocs de tailles quelconques : même sortie
+    resampler.reset();
+    int total = 0;
+    for (int start = 0, len = 1; start < 5000; start += len, len = len % 37 + 1)
+        total += resampler.process(&in[start], std::min(len, 5000 - start), &chunked[total]);
+    TEST_ASSERT_EQUAL_INT(produced, total);
+    for (int m = 0; m < produced; m++)
+        TEST_ASSERT_EQUAL_FLOAT(out[m], chunked[m]);
+
+    // 160 Hz se replierait à 18 Hz : atténué d'au moins 40 dB
+    for (int i = 0; i < 5000; i++)
+        in[i] = 100.0f * std::sin(2 * M_PI * 160.0 * i / 1000.0);
+    resampler.reset();
+    produced = resampler.process(in, 5000, out);
+    double energy = 0;
+    for (int m = 20; m < produced; m++)
+        energy += (double)out[m] * out[m];
+    TEST_ASSERT_LESS_THAN(1.0, std::sqrt(energy / (produced - 20)));
+
+    // 100 → 178 Hz (suréchantillonnage), entrée ADC : niveau continu exact
+    typedef PolyphaseResampler<100> Up100;
+    static Up100 upsampler;
+    static int adc[1000];
+    static int adc_out[Up100::maxOutput(1000)];
+    TEST_ASSERT_EQUAL_INT(89, Up100::Up);
+    TEST_ASSERT_EQUAL_INT(50, Up100::Down);
+    for (int i = 0; i < 1000; i++)
+        adc[i] = 512;
+    produced = upsampler.process(adc, 1000, adc_out);
+    TEST_ASSERT_EQUAL_INT(10 * SAMPLE_RATE, produced);
+    for (int m = 2 * RESAMPLER_TAPS_PER_PHASE; m < produced; m++)
+        TEST_ASSERT_EQUAL_INT(512, adc_out[m]);
+}
+
+void test_normalized_features_respect_capacity(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+    static float reference[MAX_FEATURES];
+    const uint32_t guard_word = 0xDEADBEEF;
+
+    // Tenseur d'entrée du modèle suivi d'un mot témoin (arène TFLite)
+    static struct
+    {
+        float input[NUM_FEATURES];
+        uint32_t guard;
+    } tensor;
+    tensor.guard = guard_word;
+
+    generateADCStream(adc, 4 * WINDOW_SIZE, 5);
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 4 * WINDOW_SIZE);
+
+    // Layout temporal : 8 blocs, plus de features que le modèle n'en consomme
+    TEST_ASSERT_TRUE(preprocessor.getFeatureCount() >= NUM_FEATURES);
+    TEST_ASSERT_TRUE(preprocessor.normalizeFeatures(tensor.input, NUM_FEATURES));
+    TEST_ASSERT_EQUAL_UINT32(guard_word, tensor.guard);
+
+    preprocessor.normalizeFeatures(reference, MAX_FEATURES);
+    TEST_ASSERT_EQUAL_MEMORY(reference, tensor.input, sizeof(tensor.input));
+
+    // Capacité inférieure au scaler : préfixe seulement
+    tensor.input[10] = -1.0f;
+    preprocessor.normalizeFeatures(tensor.input, 10);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, tensor.input[10]);
+    TEST_ASSERT_EQUAL_UINT32(guard_word, tensor.guard);
+}
+
+#ifndef EEG_SCALER_FOLDED
+void test_quantized_features_match_scaler(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+    static float normalized[MAX_FEATURES];
+    int8_t quantized[NUM_FEATURES];
+    const float input_scale = 0.04f;
+    const int input_zero_point = -7;
+
+    generateADCStream(adc, 4 * WINDOW_SIZE, 5);
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 4 * WINDOW_SIZE);
+    preprocessor.extractFeatures();
+    preprocessor.normalizeFeatures(normalized, MAX_FEATURES);
+
+    preprocessor.setInputQuantization(input_scale, input_zero_point);
+    preprocessor.quantizeFeatures(quantized);
+
+    int saturated = 0;
+    for (int i = 0; i < NUM_FEATURES; i++)
+    {
+        // Référence : Quantize TFLite appliqué à la sortie du scaler
+        float q = std::round(normalized[i] / input_scale) + input_zero_point;
+        q = std::max(-128.0f, std::min(q, 127.0f));
+        if (q == -128.0f || q == 127.0f)
+            saturated++;
+        // La fusion peut déplacer un arrondi situé à une demi-unité près
+        TEST_ASSERT_INT_WITHIN(1, (int)q, quantized[i]);
+    }
+    TEST_ASSERT_TRUE(saturated < NUM_FEATURES);
+
+    // scale = 1, zp = 0 : valeurs normalisées arrondies
+    preprocessor.setInputQuantization(1.0f, 0);
+    preprocessor.quantizeFeatures(quantized);
+    for (int i = 0; i < NUM_FEATURES; i++)
+    {
+        float q = std::max(-128.0f, std::min(std::round(normalized[i]), 127.0f));
+        TEST_ASSERT_INT_WITHIN(1, (int)q, quantized[i]);
+    }
+}
+#else
+void test_folded_scaler_passes_raw_features(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+    static float emitted[MAX_FEATURES];
+    int8_t quantized[NUM_FEATURES];
+
+    generateADCStream(adc, 4 * WINDOW_SIZE, 5);
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 4 * WINDOW_SIZE);
+    preprocessor.extractFeatures();
+
+    // Le modèle intègre le scaler : features brutes, sans normalisation
+    preprocessor.normalizeFeatures(emitted, MAX_FEATURES);
+    const float *features = preprocessor.getFeatures();
+    for (int i = 0; i < preprocessor.getFeatureCount(); i++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(features[i], emitted[i]);
+    }
+
+    preprocessor.setInputQuantization(0.5f, 3);
+    preprocessor.quantizeFeatures(quantized);
+    for (int i = 0; i < NUM_FEATURES; i++)
+    {
+        float q = std::max(-128.0f, std::min(std::round(features[i] / 0.5f) + 3, 127.0f));
+        TEST_ASSERT_INT_WITHIN(1, (int)q, quantized[i]);
+    }
+}
+#endif
+
+#ifdef BITALINO_FIXED_POINT
+
+void test_fixed_preprocessor_matches_float_kernel(void)
+{
+    static BITalinoEEGPreprocessor preprocessor;
+    static int adc[4 * WINDOW_SIZE];
+    float expected[NUM_TEMPORAL_FEATURES];
+
+    generateADCStream(adc, 4 * WINDOW_SIZE, 3);
+    preprocessor.begin();
+    ingestAll(preprocessor, adc, 4 * WINDOW_SIZE);
+
+    SegmentStats stats;
+    computeSegmentStats(preprocessor.getWindow(), WINDOW_SIZE, stats);
+    writeTemporalFeatures(stats, expected);
+
+    static float normalized[MAX_FEATURES];
+    preprocessor.extractFeatures();
+    preprocessor.normalizeFeatures(normalized, MAX_FEATURES);
+    for (int i = 0; i < NUM_TEMPORAL_FEATURES; i++)
+    {
+        if (isRatioFeature(i) || i == 0 || i == 18)
+            continue;
+#ifdef EEG_SCALER_FOLDED
+        float value = normalized[i];
+#else
+        float value = normalized[i] * scaler_scale[i] + scaler_mean[i];
+#endif
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * std::max(1.0f, std::abs(expected[i])), expected[i], value);
+    }
+}
+#endif
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fused_kernel_matches_reference_full_window);
+    RUN_TEST(test_fused_kernel_matches_reference_segments);
+    RUN_TEST(test_fused_kernel_bit_exact_except_higher_moments);
+    RUN_TEST(test_fused_kernel_constant_signal);
+    RUN_TEST(test_ring_buffer_hop_cadence);
+    RUN_TEST(test_ring_buffer_window_is_contiguous_and_ordered);
+    RUN_TEST(test_incremental_engine_tracks_batch_without_reanchor);
+    RUN_TEST(test_selection_median_matches_sort);
+    RUN_TEST(test_sliding_median_matches_sort);
+    RUN_TEST(test_biquad_block_matches_per_sample);
+    RUN_TEST(test_bandpass_is_stable_and_rejects_dc);
+    RUN_TEST(test_filter_design_matches_legacy_bandpass);
+    RUN_TEST(test_block_ingestion_matches_per_sample);
+    RUN_TEST(test_fixed_log2_accuracy);
+    RUN_TEST(test_fixed_bandpass_error_bound);
+    RUN_TEST(test_fixed_features_error_bound);
+    RUN_TEST(test_dsp_reference_kernels);
+    RUN_TEST(test_real_fft_matches_dft);
+    RUN_TEST(test_spectral_features_locate_band);
+    RUN_TEST(test_feature_layout_versions);
+    RUN_TEST(test_feature_groups_are_independent);
+    RUN_TEST(test_complexity_features_match_naive_and_bounds);
+    RUN_TEST(test_goertzel_bank_matches_window_dft);
+    RUN_TEST(test_goertzel_bank_stays_bounded);
+    RUN_TEST(test_goertzel_bank_follows_preprocessor_windows);
+    RUN_TEST(test_haar_lifting_matches_direct_transform);
+    RUN_TEST(test_wavelet_vanishing_moments);
+    RUN_TEST(test_wavelet_features_localize_band);
+    RUN_TEST(test_multichannel_biquad_matches_single_channel);
+    RUN_TEST(test_feature_set_subsets_match_full_extractor);
+    RUN_TEST(test_feature_table_duplicates);
+    RUN_TEST(test_nonlinear_features_share_fused_pass);
+    RUN_TEST(test_fast_math_error_bounds);
+    RUN_TEST(test_moment_merge_matches_single_pass);
+    RUN_TEST(test_window_features_from_merged_segments);
+    RUN_TEST(test_segment_geometry_remainder_policies);
+    RUN_TEST(test_pipeline_caches_features_per_window);
+    RUN_TEST(test_signal_quality_flags_bad_windows);
+    RUN_TEST(test_bitalino_frames_crc_sequence_and_gaps);
+    RUN_TEST(test_cascade_gate_invokes_on_activity_or_keepalive);
+    RUN_TEST(test_polyphase_resampler_rates_and_alias_rejection);
+    RUN_TEST(test_normalized_features_respect_capacity);
+#ifndef EEG_SCALER_FOLDED
+    RUN_TEST(test_quantized_features_match_scaler);
+#else
+    RUN_TEST(test_folded_scaler_passes_raw_features);
+#endif
+#ifndef BITALINO_FIXED_POINT
+    RUN_TEST(test_multichannel_preprocessor_matches_single_channel);
+#endif
+#ifdef BITALINO_FIXED_POINT
+    RUN_TEST(test_fixed_preprocessor_matches_float_kernel);
+#endif
+    return UNITY_END();
+}
@@ -11,6 +11,7 @@
 
 #include <Arduino.h>
 #include "BITalinoEEG_Preprocessor.h"
+#include "scaler_params.h"
 #include <cmath>
 
 
@@ -18,6 +19,7 @@
 
 
 #define TEST_DURATION_MS 5000  
+#define SAMPLE_PERIOD_MS (1000 / SAMPLE_RATE)
 
 
 float generateTestSignal(unsigned long time_ms, float frequency_hz) {
@@ -42,7 +44,7 @@ int signalToADC(float signal) {
     
     int adc = (int)((voltage_v / BITALINO_VCC) * BITALINO_ADC_RESOLUTION);
     
-    return constrain(adc, 0, BITALINO_ADC_RESOLUTION - 1);
+    return constrain(adc, 0, (int)BITALINO_ADC_RESOLUTION - 1);
 }
 
 
@@ -155,9 +157,8 @@ void setup() {
     Serial.println("║  TEST 4: Extraction de Features                             ║");
     Serial.println("╚══════════════════════════════════════════════════════════════╝");
     
-    float* features = preprocessor.extractFeatures();
-    
-    if (features != nullptr) {
+    if (preprocessor.extractFeatures()) {
+        const float* features = preprocessor.getFeatures();
         Serial.printf("\n  ✓ %d features extraites\n\n", NUM_FEATURES);
         
         Serial.println("  Premières 20 features:");
@@ -181,9 +182,9 @@ void setup() {
     Serial.println("║  TEST 5: Normalisation des Features                         ║");
     Serial.println("╚══════════════════════════════════════════════════════════════╝");
     
-    float* normalized = preprocessor.getNormalizedFeatures();
+    static float normalized[MAX_FEATURES];
     
-    if (normalized != nullptr) {
+    if (preprocessor.normalizeFeatures(normalized, MAX_FEATURES)) {
         Serial.println("\n  ✓ Features normalisées\n");
         
         Serial.println("  Premières 20 features normalisées:");
@@ -236,7 +237,7 @@ void setup() {
         
         if (ready) {
             unsigned long feature_start = micros();
-            preprocessor.getNormalizedFeatures();
+            preprocessor.normalizeFeatures(normalized, MAX_FEATURES);
             unsigned long feature_time = micros() - feature_start;
             
             windows_processed++;